@@ -23,6 +23,7 @@ void BBVariable::unref() {
 void BBVariable::set_value(const Variant &p_value) {
 	data->value = p_value; // Setting value even when bound as a fallback in case the binding fails.
 	data->value_changed = true;
+	data->version++;
 
 	if (is_bound()) {
 		Object *obj = ObjectDB::get_instance(ObjectID(data->bound_object));
@@ -26,6 +26,8 @@ private:
 	struct Data {
 		// Is used to decide if the value needs to be synced in a derived plan.
 		bool value_changed = false;
+		// Incremented on every write. Is used by observers to detect changes without comparing values.
+		uint32_t version = 0;
 
 		SafeRefCount refcount;
 		Variant value;
@@ -58,6 +60,7 @@ public:
 
 	_FORCE_INLINE_ bool is_value_changed() const { return data->value_changed; }
 	_FORCE_INLINE_ void reset_value_changed() { data->value_changed = false; }
+	_FORCE_INLINE_ uint32_t get_version() const { return data->version; }
 
 	bool is_same_prop_info(const BBVariable &p_other) const;
 	void copy_prop_info(const BBVariable &p_other);
@@ -12,6 +12,7 @@
 #include "blackboard.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/templates/hash_set.h"
 #include "core/variant/variant.h"
 #include "scene/main/node.h"
 #endif // LIMBOAI_MODULE
@@ -21,6 +22,7 @@
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 using namespace godot;
 #endif
 
@@ -32,36 +34,242 @@ Ref<Blackboard> Blackboard::top() const {
 	return bb;
 }
 
-Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
-	if (data.has(p_name)) {
-		return data.get(p_name).get_value();
-	} else if (parent.is_valid()) {
-		return parent->get_var(p_name, p_default, p_complain);
-	} else {
-		if (p_complain) {
-			ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
+SafeNumeric<uint32_t> Blackboard::epoch_counter(1);
+Blackboard::SharedScopeMap *Blackboard::shared_scopes = nullptr;
+
+const BBVariable *Blackboard::_find_var(const StringName &p_name) const {
+	const BBVariable *var = data.getptr(p_name);
+	if (var || parent.is_null()) {
+		return var;
+	}
+
+	if (shared) {
+		// * Shared scopes may be accessed by many agents at once, so they don't cache lookups.
+		for (const Blackboard *scope = parent.ptr(); scope; scope = scope->parent.ptr()) {
+			var = scope->data.getptr(p_name);
+			if (var) {
+				return var;
+			}
+		}
+		return nullptr;
+	}
+
+	uint32_t epoch = _get_chain_epoch();
+	if (outer_cache_epoch != epoch) {
+		outer_cache.clear();
+		outer_cache_epoch = epoch;
+	}
+	const BBVariable *const *cached = outer_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
+	}
+	for (const Blackboard *scope = parent.ptr(); scope; scope = scope->parent.ptr()) {
+		var = scope->data.getptr(p_name);
+		if (var) {
+			break;
 		}
-		return p_default;
 	}
+	if (unlikely(outer_cache.size() >= OUTER_CACHE_MAX_SIZE)) {
+		// * Misses are cached too, so the number of distinct names is bounded.
+		outer_cache.clear();
+	}
+	// * Elements of HashMap are not relocated, so the pointer stays valid until the scope chain changes.
+	outer_cache.insert(p_name, var);
+	return var;
 }
 
-void Blackboard::set_var(const StringName &p_name, const Variant &p_value) {
-	if (data.has(p_name)) {
+static bool _is_frozen(const Variant &p_value, int p_depth = 0) {
+	if (p_depth > 64) {
+		return false;
+	}
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array arr = p_value;
+		if (!arr.is_read_only()) {
+			return false;
+		}
+		for (int i = 0; i < arr.size(); i++) {
+			if (!_is_frozen(arr[i], p_depth + 1)) {
+				return false;
+			}
+		}
+	} else if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary dict = p_value;
+		if (!dict.is_read_only()) {
+			return false;
+		}
+		Array values = dict.values();
+		for (int i = 0; i < values.size(); i++) {
+			if (!_is_frozen(values[i], p_depth + 1)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Values stored in shared scopes are frozen, so agents can hold references to them without copying.
+// Nested arrays and dictionaries are frozen as well. Dictionary keys are not.
+static Variant _freeze_shared_value(const Variant &p_value, int p_depth = 0) {
+	ERR_FAIL_COND_V_MSG(p_depth > 64, Variant(), "Blackboard: Value is nested too deeply to be stored in a shared scope.");
+	if (p_depth == 0 && _is_frozen(p_value)) {
+		return p_value;
+	}
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array arr = Array(p_value).duplicate();
+		for (int i = 0; i < arr.size(); i++) {
+			arr[i] = _freeze_shared_value(arr[i], p_depth + 1);
+		}
+		arr.make_read_only();
+		return arr;
+	} else if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary dict = Dictionary(p_value).duplicate();
+		Array keys = dict.keys();
+		for (int i = 0; i < keys.size(); i++) {
+			dict[keys[i]] = _freeze_shared_value(dict[keys[i]], p_depth + 1);
+		}
+		dict.make_read_only();
+		return dict;
+	}
+	return p_value;
+}
+
+Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
+	const BBVariable *var = _find_var(p_name);
+	if (var) {
+		return var->get_value();
+	}
+	if (p_complain) {
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
+	}
+	return p_default;
+}
+
+void Blackboard::_set_var(const StringName &p_name, const Variant &p_value) {
+	BBVariable *var_ptr = data.getptr(p_name);
+	if (var_ptr) {
 		// Not checking type - allowing duck-typing.
-		data[p_name].set_value(p_value);
+		var_ptr->set_value(p_value);
 	} else {
 		BBVariable var(p_value.get_type());
 		var.set_value(p_value);
 		data.insert(p_name, var);
+		_structure_changed();
+	}
+}
+
+void Blackboard::set_var(const StringName &p_name, const Variant &p_value) {
+	if (unlikely(shared)) {
+		_set_var(p_name, _freeze_shared_value(p_value));
+	} else {
+		_set_var(p_name, p_value);
 	}
 }
 
 bool Blackboard::has_var(const StringName &p_name) const {
-	return data.has(p_name) || (parent.is_valid() && parent->has_var(p_name));
+	return _find_var(p_name) != nullptr;
 }
 
 void Blackboard::erase_var(const StringName &p_name) {
-	data.erase(p_name);
+	if (data.erase(p_name)) {
+		_structure_changed();
+	}
+}
+
+// Returns a dense ID for p_name, which can be used to access the variable without hashing its name.
+// IDs are only valid for this blackboard. Not thread-safe: intern names during setup or from the thread that owns the blackboard.
+uint32_t Blackboard::intern_var(const StringName &p_name) {
+	ERR_FAIL_COND_V(p_name == StringName(), INVALID_VAR_ID);
+	const uint32_t *id = symbol_ids.getptr(p_name);
+	if (id) {
+		return *id;
+	}
+	uint32_t new_id = symbols.size();
+	Symbol sym;
+	sym.name = p_name;
+	symbols.push_back(sym);
+	symbol_ids.insert(p_name, new_id);
+	return new_id;
+}
+
+const Blackboard::Symbol &Blackboard::_resolve_symbol(uint32_t p_id) const {
+	Symbol &sym = symbols[p_id];
+	uint32_t epoch = _get_chain_epoch();
+	if (unlikely(sym.epoch != epoch)) {
+		// * Elements of HashMap are not relocated, so the pointer stays valid until the scope chain changes.
+		sym.var = data.getptr(sym.name);
+		sym.local = sym.var != nullptr;
+		if (!sym.local) {
+			sym.var = _find_var(sym.name);
+		}
+		sym.epoch = epoch;
+	}
+	return sym;
+}
+
+Variant Blackboard::get_var_by_id(uint32_t p_id, const Variant &p_default, bool p_complain) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, symbols.size(), p_default);
+	if (unlikely(shared)) {
+		// * Shared scopes may be accessed by many agents at once, so they don't cache lookups.
+		return get_var(symbols[p_id].name, p_default, p_complain);
+	}
+	const Symbol &sym = _resolve_symbol(p_id);
+	if (sym.var) {
+		return sym.var->get_value();
+	}
+	if (p_complain) {
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", sym.name));
+	}
+	return p_default;
+}
+
+void Blackboard::set_var_by_id(uint32_t p_id, const Variant &p_value) {
+	ERR_FAIL_UNSIGNED_INDEX(p_id, symbols.size());
+	if (unlikely(shared)) {
+		set_var(symbols[p_id].name, p_value);
+		return;
+	}
+	const Symbol &sym = _resolve_symbol(p_id);
+	if (sym.local) {
+		const_cast<BBVariable *>(sym.var)->set_value(p_value);
+	} else {
+		_set_var(sym.name, p_value);
+	}
+}
+
+bool Blackboard::has_var_by_id(uint32_t p_id) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, symbols.size(), false);
+	if (unlikely(shared)) {
+		return has_var(symbols[p_id].name);
+	}
+	return _resolve_symbol(p_id).var != nullptr;
+}
+
+// Returns a value that changes whenever the variable is written to, or resolves to a different variable.
+// Bound variables can change without being written to, so their stamp is always VAR_STAMP_VOLATILE.
+uint64_t Blackboard::get_var_stamp_by_id(uint32_t p_id) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, symbols.size(), VAR_STAMP_VOLATILE);
+	const BBVariable *var;
+	uint32_t epoch;
+	if (unlikely(shared)) {
+		epoch = _get_chain_epoch();
+		var = _find_var(symbols[p_id].name);
+	} else {
+		const Symbol &sym = _resolve_symbol(p_id);
+		epoch = sym.epoch;
+		var = sym.var;
+	}
+	if (var == nullptr) {
+		return uint64_t(epoch) << 32;
+	}
+	if (var->is_bound()) {
+		return VAR_STAMP_VOLATILE;
+	}
+	return (uint64_t(epoch) << 32) | var->get_version();
+}
+
+StringName Blackboard::get_interned_name(uint32_t p_id) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, symbols.size(), StringName());
+	return symbols[p_id].name;
 }
 
 TypedArray<StringName> Blackboard::list_vars() const {
@@ -98,6 +306,7 @@ void Blackboard::bind_var_to_property(const StringName &p_name, Object *p_object
 	if (!data.has(p_name)) {
 		if (p_create) {
 			data.insert(p_name, BBVariable());
+			_structure_changed();
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't bind variable that doesn't exist (var: " + p_name + ").");
 		}
@@ -112,12 +321,14 @@ void Blackboard::unbind_var(const StringName &p_name) {
 
 void Blackboard::assign_var(const StringName &p_name, const BBVariable &p_var) {
 	data.insert(p_name, p_var);
+	_structure_changed();
 }
 
 void Blackboard::link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create) {
 	if (!data.has(p_name)) {
 		if (p_create) {
 			data.insert(p_name, BBVariable());
+			_structure_changed();
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't link variable that doesn't exist (var: " + p_name + ").");
 		}
@@ -127,12 +338,228 @@ void Blackboard::link_var(const StringName &p_name, const Ref<Blackboard> &p_tar
 	data[p_name] = p_target_blackboard->data[p_target_var];
 }
 
+// * Packed format: magic, version, flags, number of entries, entries (name, value),
+// * and for deltas, number of erased variables followed by their names.
+static constexpr uint32_t PACKED_MAGIC = 0x5642424C; // "LBBV"
+static constexpr uint8_t PACKED_VERSION = 1;
+static constexpr uint8_t PACKED_FLAG_DELTA = 1;
+
+static bool _read_packed_header(LimboBinaryReader &p_reader, uint8_t &r_flags) {
+	uint32_t magic = p_reader.get_u32();
+	uint8_t version = p_reader.get_u8();
+	r_flags = p_reader.get_u8();
+	return !p_reader.has_error() && magic == PACKED_MAGIC && version == PACKED_VERSION;
+}
+
+// Visits variables visible from this scope. With p_include_parents, closer scopes shadow outer ones.
+template <typename F>
+void Blackboard::_for_each_export_var(bool p_include_parents, bool p_skip_bound, F p_func) const {
+	if (!p_include_parents || parent.is_null()) {
+		for (const KeyValue<StringName, BBVariable> &kv : data) {
+			if (!p_skip_bound || !kv.value.is_bound()) {
+				p_func(kv.key, kv.value);
+			}
+		}
+		return;
+	}
+	HashSet<StringName> visited;
+	for (const Blackboard *scope = this; scope; scope = scope->parent.ptr()) {
+		for (const KeyValue<StringName, BBVariable> &kv : scope->data) {
+			if (visited.has(kv.key)) {
+				continue;
+			}
+			visited.insert(kv.key);
+			if (!p_skip_bound || !kv.value.is_bound()) {
+				p_func(kv.key, kv.value);
+			}
+		}
+	}
+}
+
+PackedByteArray Blackboard::export_vars(bool p_include_parents, bool p_skip_bound) const {
+	LimboBinaryWriter writer;
+	writer.put_u32(PACKED_MAGIC);
+	writer.put_u8(PACKED_VERSION);
+	writer.put_u8(0);
+	uint32_t count_pos = writer.reserve_u32();
+	uint32_t count = 0;
+	_for_each_export_var(p_include_parents, p_skip_bound, [&](const StringName &p_name, const BBVariable &p_var) {
+		writer.put_string_name(p_name);
+		writer.put_var(p_var.get_value());
+		count += 1;
+	});
+	writer.patch_u32(count_pos, count);
+	return writer.to_packed();
+}
+
+PackedByteArray Blackboard::export_vars_delta(const PackedByteArray &p_base, bool p_include_parents, bool p_skip_bound) const {
+	struct EncodedValue {
+		const uint8_t *ptr = nullptr;
+		uint32_t size = 0;
+	};
+
+	// Index base values by name. Values point into p_base and are compared in encoded form, so nothing is decoded.
+	HashMap<StringName, EncodedValue> base_values;
+	LimboBinaryReader reader(p_base);
+	uint8_t base_flags = 0;
+	ERR_FAIL_COND_V_MSG(!_read_packed_header(reader, base_flags) || (base_flags & PACKED_FLAG_DELTA), PackedByteArray(), "Blackboard: Delta base must be produced by export_vars().");
+	uint32_t num_base = reader.get_u32();
+	for (uint32_t i = 0; i < num_base && !reader.has_error(); i++) {
+		StringName name = reader.get_string_name();
+		EncodedValue value;
+		value.ptr = reader.get_var_raw(value.size);
+		base_values.insert(name, value);
+	}
+	ERR_FAIL_COND_V_MSG(reader.has_error(), PackedByteArray(), "Blackboard: Delta base is corrupted.");
+
+	LimboBinaryWriter writer;
+	writer.put_u32(PACKED_MAGIC);
+	writer.put_u8(PACKED_VERSION);
+	writer.put_u8(PACKED_FLAG_DELTA);
+	uint32_t count_pos = writer.reserve_u32();
+	uint32_t count = 0;
+	_for_each_export_var(p_include_parents, p_skip_bound, [&](const StringName &p_name, const BBVariable &p_var) {
+		uint32_t entry_start = writer.size();
+		writer.put_string_name(p_name);
+		uint32_t value_start = writer.size();
+		writer.put_var(p_var.get_value());
+
+		const EncodedValue *base = base_values.getptr(p_name);
+		if (base) {
+			uint32_t value_size = writer.size() - value_start;
+			if (base->size == value_size && memcmp(base->ptr, writer.ptr() + value_start, value_size) == 0) {
+				writer.truncate(entry_start); // * Unchanged.
+			} else {
+				count += 1;
+			}
+			base_values.erase(p_name);
+		} else {
+			count += 1;
+		}
+	});
+	writer.patch_u32(count_pos, count);
+
+	// * Whatever is left in the base was erased since.
+	writer.put_u32(base_values.size());
+	for (const KeyValue<StringName, EncodedValue> &kv : base_values) {
+		writer.put_string_name(kv.key);
+	}
+	return writer.to_packed();
+}
+
+Error Blackboard::import_vars(const PackedByteArray &p_data) {
+	LimboBinaryReader reader(p_data);
+	uint8_t flags = 0;
+	ERR_FAIL_COND_V_MSG(!_read_packed_header(reader, flags), ERR_FILE_UNRECOGNIZED, "Blackboard: Unrecognized packed data format.");
+
+	uint32_t num_vars = reader.get_u32();
+	for (uint32_t i = 0; i < num_vars && !reader.has_error(); i++) {
+		StringName name = reader.get_string_name();
+		Variant value = reader.get_var();
+		if (!reader.has_error()) {
+			set_var(name, value);
+		}
+	}
+	if (flags & PACKED_FLAG_DELTA) {
+		uint32_t num_erased = reader.get_u32();
+		for (uint32_t i = 0; i < num_erased && !reader.has_error(); i++) {
+			StringName name = reader.get_string_name();
+			if (!reader.has_error()) {
+				erase_var(name);
+			}
+		}
+	}
+	ERR_FAIL_COND_V_MSG(reader.has_error(), ERR_INVALID_DATA, "Blackboard: Packed data is corrupted.");
+	return OK;
+}
+
+void Blackboard::save_state_to(LimboBinaryWriter &p_writer) const {
+	p_writer.put_u32(data.size());
+	_for_each_export_var(false, false, [&](const StringName &p_name, const BBVariable &p_var) {
+		p_writer.put_string_name(p_name);
+		p_writer.put_var(p_var.get_value());
+	});
+}
+
+Error Blackboard::load_state_from(LimboBinaryReader &p_reader) {
+	// * Decode everything first, so that a read error leaves the blackboard untouched.
+	HashMap<StringName, Variant> values;
+	uint32_t num_vars = p_reader.get_u32();
+	for (uint32_t i = 0; i < num_vars && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		Variant value = p_reader.get_var();
+		if (!p_reader.has_error()) {
+			values.insert(name, value);
+		}
+	}
+	ERR_FAIL_COND_V_MSG(p_reader.has_error(), ERR_INVALID_DATA, "Blackboard: Failed to read state.");
+
+	// * Variables created after the snapshot was taken are dropped.
+	LocalVector<StringName> stale;
+	for (const KeyValue<StringName, BBVariable> &kv : data) {
+		if (!values.has(kv.key)) {
+			stale.push_back(kv.key);
+		}
+	}
+	for (const StringName &name : stale) {
+		erase_var(name);
+	}
+	for (const KeyValue<StringName, Variant> &kv : values) {
+		set_var(kv.key, kv.value);
+	}
+	return OK;
+}
+
+PackedByteArray Blackboard::save_state() const {
+	LimboBinaryWriter writer;
+	save_state_to(writer);
+	return writer.to_packed();
+}
+
+Error Blackboard::load_state(const PackedByteArray &p_state) {
+	LimboBinaryReader reader(p_state);
+	return load_state_from(reader);
+}
+
+Ref<Blackboard> Blackboard::get_shared_scope(const StringName &p_name) {
+	if (shared_scopes == nullptr) {
+		shared_scopes = memnew(SharedScopeMap);
+	}
+	Ref<Blackboard> *existing = shared_scopes->getptr(p_name);
+	if (existing) {
+		return *existing;
+	}
+	Ref<Blackboard> scope = memnew(Blackboard);
+	scope->set_shared(true);
+	shared_scopes->insert(p_name, scope);
+	return scope;
+}
+
+bool Blackboard::has_shared_scope(const StringName &p_name) {
+	return shared_scopes && shared_scopes->has(p_name);
+}
+
+void Blackboard::remove_shared_scope(const StringName &p_name) {
+	if (shared_scopes) {
+		shared_scopes->erase(p_name);
+	}
+}
+
+void Blackboard::clear_shared_scopes() {
+	if (shared_scopes) {
+		memdelete(shared_scopes);
+		shared_scopes = nullptr;
+	}
+}
+
 void Blackboard::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_var", "var_name", "default", "complain"), &Blackboard::get_var, DEFVAL(Variant()), DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("set_var", "var_name", "value"), &Blackboard::set_var);
 	ClassDB::bind_method(D_METHOD("has_var", "var_name"), &Blackboard::has_var);
 	ClassDB::bind_method(D_METHOD("set_parent", "blackboard"), &Blackboard::set_parent);
 	ClassDB::bind_method(D_METHOD("get_parent"), &Blackboard::get_parent);
+	ClassDB::bind_method(D_METHOD("set_shared", "shared"), &Blackboard::set_shared);
+	ClassDB::bind_method(D_METHOD("is_shared"), &Blackboard::is_shared);
 	ClassDB::bind_method(D_METHOD("erase_var", "var_name"), &Blackboard::erase_var);
 	ClassDB::bind_method(D_METHOD("clear"), &Blackboard::clear);
 	ClassDB::bind_method(D_METHOD("list_vars"), &Blackboard::list_vars);
@@ -142,4 +569,13 @@ void Blackboard::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bind_var_to_property", "var_name", "object", "property", "create"), &Blackboard::bind_var_to_property, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("unbind_var", "var_name"), &Blackboard::unbind_var);
 	ClassDB::bind_method(D_METHOD("link_var", "var_name", "target_blackboard", "target_var", "create"), &Blackboard::link_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("export_vars", "include_parents", "skip_bound"), &Blackboard::export_vars, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("export_vars_delta", "base", "include_parents", "skip_bound"), &Blackboard::export_vars_delta, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("import_vars", "data"), &Blackboard::import_vars);
+	ClassDB::bind_method(D_METHOD("save_state"), &Blackboard::save_state);
+
+	ClassDB::bind_static_method("Blackboard", D_METHOD("get_shared_scope", "name"), &Blackboard::get_shared_scope);
+	ClassDB::bind_static_method("Blackboard", D_METHOD("has_shared_scope", "name"), &Blackboard::has_shared_scope);
+	ClassDB::bind_static_method("Blackboard", D_METHOD("remove_shared_scope", "name"), &Blackboard::remove_shared_scope);
+	ClassDB::bind_method(D_METHOD("load_state", "state"), &Blackboard::load_state);
 }
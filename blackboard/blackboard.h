@@ -14,9 +14,13 @@
 
 #include "bb_variable.h"
 
+#include "../util/limbo_binary_io.h"
+
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "scene/main/node.h"
 #endif // LIMBOAI_MODULE
@@ -27,30 +31,96 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 class Blackboard : public RefCounted {
 	GDCLASS(Blackboard, RefCounted);
+	friend class BlackboardPlan;
 
 private:
 	HashMap<StringName, BBVariable> data;
 	Ref<Blackboard> parent;
+	bool shared = false;
+
+	// Epoch of the last change to this scope's set of variables or its parent. Epochs are drawn from a global counter,
+	// so the highest epoch in a scope chain changes whenever any scope in the chain changes.
+	uint32_t structure_epoch = epoch_counter.increment();
+
+	// Variables resolved in outer scopes (nullptr if not found). Invalidated when any scope in the chain changes its set of variables or its parent.
+	mutable HashMap<StringName, const BBVariable *> outer_cache;
+	mutable uint32_t outer_cache_epoch = 0;
+	static constexpr uint32_t OUTER_CACHE_MAX_SIZE = 256;
+
+	// Variable names interned by hot paths, indexed by dense IDs. Each entry caches the resolved variable until the scope structure changes.
+	struct Symbol {
+		StringName name;
+		const BBVariable *var = nullptr;
+		uint32_t epoch = 0;
+		bool local = false;
+	};
+	mutable LocalVector<Symbol> symbols;
+	HashMap<StringName, uint32_t> symbol_ids;
+
+	static SafeNumeric<uint32_t> epoch_counter;
+	typedef HashMap<StringName, Ref<Blackboard>> SharedScopeMap;
+	static SharedScopeMap *shared_scopes;
+
+	_FORCE_INLINE_ void _structure_changed() { structure_epoch = epoch_counter.increment(); }
+	_FORCE_INLINE_ uint32_t _get_chain_epoch() const {
+		uint32_t epoch = structure_epoch;
+		for (const Blackboard *scope = parent.ptr(); scope; scope = scope->parent.ptr()) {
+			epoch = MAX(epoch, scope->structure_epoch);
+		}
+		return epoch;
+	}
+	const BBVariable *_find_var(const StringName &p_name) const;
+	void _set_var(const StringName &p_name, const Variant &p_value);
+	const Symbol &_resolve_symbol(uint32_t p_id) const;
+
+	template <typename F>
+	void _for_each_export_var(bool p_include_parents, bool p_skip_bound, F p_func) const;
 
 protected:
 	static void _bind_methods();
 
 public:
-	void set_parent(const Ref<Blackboard> &p_blackboard) { parent = p_blackboard; }
+	static constexpr uint32_t INVALID_VAR_ID = UINT32_MAX;
+	static constexpr uint64_t VAR_STAMP_VOLATILE = UINT64_MAX;
+
+	void set_parent(const Ref<Blackboard> &p_blackboard) {
+		parent = p_blackboard;
+		_structure_changed();
+	}
 	Ref<Blackboard> get_parent() const { return parent; }
 
+	void set_shared(bool p_shared) { shared = p_shared; }
+	bool is_shared() const { return shared; }
+
+	static Ref<Blackboard> get_shared_scope(const StringName &p_name);
+	static bool has_shared_scope(const StringName &p_name);
+	static void remove_shared_scope(const StringName &p_name);
+	static void clear_shared_scopes();
+
 	Ref<Blackboard> top() const;
 
 	Variant get_var(const StringName &p_name, const Variant &p_default = Variant(), bool p_complain = true) const;
 	void set_var(const StringName &p_name, const Variant &p_value);
 	bool has_var(const StringName &p_name) const;
 	void erase_var(const StringName &p_name);
-	void clear() { data.clear(); }
+
+	uint32_t intern_var(const StringName &p_name);
+	Variant get_var_by_id(uint32_t p_id, const Variant &p_default = Variant(), bool p_complain = true) const;
+	void set_var_by_id(uint32_t p_id, const Variant &p_value);
+	bool has_var_by_id(uint32_t p_id) const;
+	uint64_t get_var_stamp_by_id(uint32_t p_id) const;
+	StringName get_interned_name(uint32_t p_id) const;
+	void clear() {
+		data.clear();
+		_structure_changed();
+	}
 	TypedArray<StringName> list_vars() const;
 
 	Dictionary get_vars_as_dict() const;
@@ -62,6 +132,15 @@ public:
 	void assign_var(const StringName &p_name, const BBVariable &p_var);
 
 	void link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create = false);
+
+	PackedByteArray export_vars(bool p_include_parents = false, bool p_skip_bound = false) const;
+	PackedByteArray export_vars_delta(const PackedByteArray &p_base, bool p_include_parents = false, bool p_skip_bound = false) const;
+	Error import_vars(const PackedByteArray &p_data);
+
+	void save_state_to(LimboBinaryWriter &p_writer) const;
+	Error load_state_from(LimboBinaryReader &p_reader);
+	PackedByteArray save_state() const;
+	Error load_state(const PackedByteArray &p_state);
 };
 
 #endif // BLACKBOARD_H
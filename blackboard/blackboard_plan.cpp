@@ -43,6 +43,7 @@ bool BlackboardPlan::_set(const StringName &p_name, const Variant &p_value) {
 			}
 			parent_scope_mapping[mapped_var_name] = value;
 		}
+		_invalidate_init_template();
 		if (properties_changed) {
 			notify_property_list_changed();
 		}
@@ -183,8 +184,13 @@ void BlackboardPlan::set_base_plan(const Ref<BlackboardPlan> &p_base) {
 	if (p_base == this) {
 		WARN_PRINT_ED("BlackboardPlan: Using same resource for derived blackboard plan is not supported.");
 		base.unref();
-	} else {
+	} else if (base != p_base) {
 		base = p_base;
+		full_sync_needed = true;
+	} else {
+		// * Same base plan: only its changes need to be applied.
+		sync_with_base_plan();
+		return;
 	}
 	sync_with_base_plan();
 	notify_property_list_changed();
@@ -212,19 +218,60 @@ bool BlackboardPlan::is_prefetching_nodepath_vars() const {
 	}
 }
 
+void BlackboardPlan::_log_change(const StringName &p_old_name, const StringName &p_new_name) {
+	// * Derived plans that fall behind the log are fully re-synced.
+	static constexpr uint32_t MAX_LOGGED_CHANGES = 64;
+	if (change_log.size() >= MAX_LOGGED_CHANGES) {
+		change_log.remove_at(0);
+	}
+	structure_revision += 1;
+	StructureChange change;
+	change.revision = structure_revision;
+	change.old_name = p_old_name;
+	change.new_name = p_new_name;
+	change_log.push_back(change);
+	_invalidate_init_template();
+}
+
+void BlackboardPlan::_add_var(const StringName &p_name, const BBVariable &p_var) {
+	var_map.insert(p_name, p_var);
+	var_list.push_back(Pair<StringName, BBVariable>(p_name, p_var));
+	_log_change(StringName(), p_name);
+}
+
+void BlackboardPlan::_remove_var(const StringName &p_name) {
+	var_list.erase(Pair<StringName, BBVariable>(p_name, var_map[p_name]));
+	var_map.erase(p_name);
+	_log_change(p_name, StringName());
+}
+
+void BlackboardPlan::_rename_var(const StringName &p_name, const StringName &p_new_name) {
+	BBVariable var = var_map[p_name];
+	Pair<StringName, BBVariable> new_entry(p_new_name, var);
+	Pair<StringName, BBVariable> old_entry(p_name, var);
+	var_list.find(old_entry)->set(new_entry);
+
+	var_map.erase(p_name);
+	var_map.insert(p_new_name, var);
+
+	if (parent_scope_mapping.has(p_name)) {
+		parent_scope_mapping[p_new_name] = parent_scope_mapping[p_name];
+		parent_scope_mapping.erase(p_name);
+	}
+	_log_change(p_name, p_new_name);
+}
+
 void BlackboardPlan::add_var(const StringName &p_name, const BBVariable &p_var) {
 	ERR_FAIL_COND(p_name == StringName());
 	ERR_FAIL_COND(var_map.has(p_name));
-	var_map.insert(p_name, p_var);
-	var_list.push_back(Pair<StringName, BBVariable>(p_name, p_var));
+	_add_var(p_name, p_var);
 	notify_property_list_changed();
 	emit_changed();
 }
 
 void BlackboardPlan::remove_var(const StringName &p_name) {
 	ERR_FAIL_COND(!var_map.has(p_name));
-	var_list.erase(Pair<StringName, BBVariable>(p_name, var_map[p_name]));
-	var_map.erase(p_name);
+	_remove_var(p_name);
 	notify_property_list_changed();
 	emit_changed();
 }
@@ -274,19 +321,7 @@ void BlackboardPlan::rename_var(const StringName &p_name, const StringName &p_ne
 	ERR_FAIL_COND(!var_map.has(p_name));
 	ERR_FAIL_COND(var_map.has(p_new_name));
 
-	BBVariable var = var_map[p_name];
-	Pair<StringName, BBVariable> new_entry(p_new_name, var);
-	Pair<StringName, BBVariable> old_entry(p_name, var);
-	var_list.find(old_entry)->set(new_entry);
-
-	var_map.erase(p_name);
-	var_map.insert(p_new_name, var);
-
-	if (parent_scope_mapping.has(p_name)) {
-		parent_scope_mapping[p_new_name] = parent_scope_mapping[p_name];
-		parent_scope_mapping.erase(p_name);
-	}
-
+	_rename_var(p_name, p_new_name);
 	notify_property_list_changed();
 	emit_changed();
 }
@@ -313,28 +348,95 @@ void BlackboardPlan::move_var(int p_index, int p_new_index) {
 		var_list.move_before(E2, E);
 	}
 
+	_invalidate_init_template();
 	notify_property_list_changed();
 	emit_changed();
 }
 
+// Applies structural changes logged by the base plan since the last sync.
+// Returns false if the log doesn't cover them, or if the result doesn't match the base plan.
+bool BlackboardPlan::_replay_base_changes() {
+	if (full_sync_needed) {
+		return false;
+	}
+	const LocalVector<StructureChange> &log = base->change_log;
+	if (base->structure_revision != synced_base_revision && (log.is_empty() || log[0].revision > synced_base_revision + 1)) {
+		// * The log doesn't reach back to the last sync.
+		return false;
+	}
+	for (const StructureChange &change : log) {
+		if (change.revision <= synced_base_revision) {
+			// * Already replayed.
+			continue;
+		}
+		if (change.old_name == StringName()) {
+			// * Added
+			if (!var_map.has(change.new_name) && base->var_map.has(change.new_name)) {
+				_add_var(change.new_name, base->var_map[change.new_name].duplicate());
+			}
+		} else if (change.new_name == StringName()) {
+			// * Removed
+			if (var_map.has(change.old_name)) {
+				_remove_var(change.old_name);
+			}
+		} else {
+			// * Renamed: keeps the value overridden in this plan.
+			if (var_map.has(change.old_name) && !var_map.has(change.new_name)) {
+				_rename_var(change.old_name, change.new_name);
+			}
+		}
+	}
+	if (var_list.size() != base->var_list.size()) {
+		return false;
+	}
+	for (const Pair<StringName, BBVariable> &p : base->var_list) {
+		if (!var_map.has(p.first)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Adds variables missing from this plan and removes the ones that don't exist in the base plan.
+void BlackboardPlan::_diff_with_base() {
+	for (const Pair<StringName, BBVariable> &p : base->var_list) {
+		if (!var_map.has(p.first)) {
+			_add_var(p.first, p.second.duplicate());
+		}
+	}
+	if (var_list.size() != base->var_list.size()) {
+		LocalVector<StringName> erase_list;
+		for (const Pair<StringName, BBVariable> &p : var_list) {
+			if (!base->var_map.has(p.first)) {
+				erase_list.push_back(p.first);
+			}
+		}
+		for (const StringName &name : erase_list) {
+			_remove_var(name);
+		}
+	}
+}
+
 void BlackboardPlan::sync_with_base_plan() {
 	if (base.is_null()) {
 		return;
 	}
 
-	bool changed = false;
+	// * Structural changes are applied without notifications; those are emitted once at the end.
+	uint32_t revision = structure_revision;
+	if (!_replay_base_changes()) {
+		_diff_with_base();
+	}
+	bool changed = revision != structure_revision;
+	full_sync_needed = false;
+	synced_base_revision = base->structure_revision;
+	ERR_FAIL_COND(base->var_list.size() != var_list.size());
 
-	// Sync variables with the base plan.
+	// Sync variable properties and values with the base plan.
 	for (const Pair<StringName, BBVariable> &p : base->var_list) {
 		const StringName &base_name = p.first;
 		const BBVariable &base_var = p.second;
 
-		if (!var_map.has(base_name)) {
-			add_var(base_name, base_var.duplicate());
-			changed = true;
-			continue;
-		}
-
 		BBVariable var = var_map[base_name];
 		if (!var.is_same_prop_info(base_var)) {
 			var.copy_prop_info(base_var);
@@ -349,36 +451,20 @@ void BlackboardPlan::sync_with_base_plan() {
 		}
 	}
 
-	// Erase variables that do not exist in the base plan.
-	List<StringName> erase_list;
-	for (const Pair<StringName, BBVariable> &p : var_list) {
-		if (!base->has_var(p.first)) {
-			erase_list.push_back(p.first);
-			changed = true;
-		}
-	}
-	while (erase_list.size()) {
-		remove_var(erase_list.front()->get());
-		erase_list.pop_front();
+	// Sync order of variables: rebuilt in a single pass when any variable is out of place.
+	const List<Pair<StringName, BBVariable>>::Element *B = base->var_list.front();
+	const List<Pair<StringName, BBVariable>>::Element *E = var_list.front();
+	while (E && E->get().first == B->get().first) {
+		E = E->next();
+		B = B->next();
 	}
-
-	// Sync order of variables.
-	// Glossary: E - element of current plan, B - element of base plan, F - element of current plan (used for forward search).
-	ERR_FAIL_COND(base->var_list.size() != var_list.size());
-	List<Pair<StringName, BBVariable>>::Element *B = base->var_list.front();
-	for (List<Pair<StringName, BBVariable>>::Element *E = var_list.front(); E; E = E->next()) {
-		if (E->get().first != B->get().first) {
-			List<Pair<StringName, BBVariable>>::Element *F = E->next();
-			while (F) {
-				if (F->get().first == B->get().first) {
-					var_list.move_before(F, E);
-					E = F;
-					break;
-				}
-				F = F->next();
-			}
+	if (E) {
+		var_list.clear();
+		for (const Pair<StringName, BBVariable> &p : base->var_list) {
+			var_list.push_back(Pair<StringName, BBVariable>(p.first, var_map[p.first]));
 		}
-		B = B->next();
+		_invalidate_init_template();
+		changed = true;
 	}
 
 	if (changed) {
@@ -387,25 +473,20 @@ void BlackboardPlan::sync_with_base_plan() {
 	}
 }
 
-// Add a variable duplicate to the blackboard, optionally with NodePath prefetch.
-inline void bb_add_var_dup_with_prefetch(const Ref<Blackboard> &p_blackboard, const StringName &p_name, const BBVariable &p_var, bool p_prefetch, Node *p_node) {
-	if (unlikely(p_prefetch && p_var.get_type() == Variant::NODE_PATH)) {
-		Node *n = p_node->get_node_or_null(p_var.get_value());
-		BBVariable var = p_var.duplicate();
-		if (n != nullptr) {
-			var.set_value(n);
-		} else {
-			if (p_blackboard->has_var(p_name)) {
-				// Not adding: Assuming variable was initialized by the user or in the parent scope.
-				return;
-			}
-			ERR_PRINT(vformat("BlackboardPlan: Prefetch failed for variable $%s with value: %s", p_name, p_var.get_value()));
-			var.set_value(Variant());
+void BlackboardPlan::_compile_init_template() {
+	init_template.clear();
+	init_template.reserve(var_list.size());
+	for (const Pair<StringName, BBVariable> &p : var_list) {
+		InitEntry entry;
+		entry.name = p.first;
+		entry.var = p.second;
+		const StringName *target = parent_scope_mapping.getptr(p.first);
+		if (target != nullptr) {
+			entry.mapping_target = *target;
 		}
-		p_blackboard->assign_var(p_name, var);
-	} else {
-		p_blackboard->assign_var(p_name, p_var.duplicate());
+		init_template.push_back(entry);
 	}
+	init_template_dirty = false;
 }
 
 Ref<Blackboard> BlackboardPlan::create_blackboard(Node *p_node, const Ref<Blackboard> &p_parent_scope) {
@@ -418,19 +499,38 @@ Ref<Blackboard> BlackboardPlan::create_blackboard(Node *p_node, const Ref<Blackb
 
 void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bool overwrite, Node *p_node) {
 	ERR_FAIL_COND(p_node == nullptr && prefetch_nodepath_vars);
-	for (const Pair<StringName, BBVariable> &p : var_list) {
-		if (p_blackboard->has_var(p.first) && !overwrite) {
+	ERR_FAIL_COND(p_blackboard.is_null());
+	if (unlikely(init_template_dirty)) {
+		_compile_init_template();
+	}
+
+	// * Variables are inserted directly, and outer-scope caches are invalidated once at the end.
+	HashMap<StringName, BBVariable> &data = p_blackboard->data;
+	data.reserve(data.size() + init_template.size());
+	for (const InitEntry &entry : init_template) {
+		if (!overwrite && p_blackboard->has_var(entry.name)) {
 			continue;
 		}
-		bb_add_var_dup_with_prefetch(p_blackboard, p.first, p.second, prefetch_nodepath_vars, p_node);
-		if (parent_scope_mapping.has(p.first)) {
-			StringName target_var = parent_scope_mapping[p.first];
-			if (target_var != StringName()) {
-				ERR_CONTINUE_MSG(p_blackboard->get_parent() == nullptr, vformat("BlackboardPlan: Cannot link variable $%s to parent scope because the parent scope is not set.", p.first));
-				p_blackboard->link_var(p.first, p_blackboard->get_parent(), target_var);
+		BBVariable var = entry.var.duplicate();
+		if (unlikely(prefetch_nodepath_vars && var.get_type() == Variant::NODE_PATH)) {
+			Node *n = p_node->get_node_or_null(var.get_value());
+			if (n != nullptr) {
+				var.set_value(n);
+			} else if (p_blackboard->has_var(entry.name)) {
+				// Not adding: Assuming variable was initialized by the user or in the parent scope.
+				continue;
+			} else {
+				ERR_PRINT(vformat("BlackboardPlan: Prefetch failed for variable $%s with value: %s", entry.name, entry.var.get_value()));
+				var.set_value(Variant());
 			}
 		}
+		data.insert(entry.name, var);
+		if (entry.mapping_target != StringName()) {
+			ERR_CONTINUE_MSG(p_blackboard->get_parent() == nullptr, vformat("BlackboardPlan: Cannot link variable $%s to parent scope because the parent scope is not set.", entry.name));
+			p_blackboard->link_var(entry.name, p_blackboard->get_parent(), entry.mapping_target);
+		}
 	}
+	p_blackboard->_structure_changed();
 }
 
 void BlackboardPlan::_bind_methods() {
@@ -17,10 +17,12 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
@@ -46,6 +48,41 @@ private:
 	// If true, NodePath variables will be prefetched, so that the vars will contain node pointers instead (upon BB creation/population).
 	bool prefetch_nodepath_vars = true;
 
+	// Flat initialization template used by populate_blackboard(), compiled from var_list on first use.
+	// Entries share data with var_list, so edits to values and types don't require recompilation.
+	struct InitEntry {
+		StringName name;
+		BBVariable var;
+		StringName mapping_target;
+	};
+	LocalVector<InitEntry> init_template;
+	bool init_template_dirty = true;
+
+	void _compile_init_template();
+	_FORCE_INLINE_ void _invalidate_init_template() { init_template_dirty = true; }
+
+	// Recent structural changes, replayed by derived plans in sync_with_base_plan().
+	// Added variables have an empty old_name, removed ones an empty new_name.
+	struct StructureChange {
+		uint32_t revision = 0;
+		StringName old_name;
+		StringName new_name;
+	};
+	LocalVector<StructureChange> change_log;
+	uint32_t structure_revision = 0;
+	// Revision of the base plan this plan was last synced with.
+	uint32_t synced_base_revision = 0;
+	bool full_sync_needed = true;
+
+	void _log_change(const StringName &p_old_name, const StringName &p_new_name);
+	bool _replay_base_changes();
+	void _diff_with_base();
+
+	// Structural edits without notifications.
+	void _add_var(const StringName &p_name, const BBVariable &p_var);
+	void _remove_var(const StringName &p_name);
+	void _rename_var(const StringName &p_name, const StringName &p_new_name);
+
 protected:
 	static void _bind_methods();
 
@@ -64,6 +101,8 @@ public:
 
 	bool is_mapping_enabled() const { return parent_scope_plan_provider.is_valid() && (parent_scope_plan_provider.call() != Ref<BlackboardPlan>()); }
 	bool has_mapping(const StringName &p_name) const;
+	// Returns mapping between variables in this plan and their parent scope names, regardless of whether mapping is currently available.
+	const HashMap<StringName, StringName> &get_parent_scope_mapping() const { return parent_scope_mapping; }
 
 	void set_prefetch_nodepath_vars(bool p_enable);
 	bool is_prefetching_nodepath_vars() const;
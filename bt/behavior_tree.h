@@ -58,7 +58,7 @@ public:
 
 	Ref<BehaviorTree> clone() const;
 	void copy_other(const Ref<BehaviorTree> &p_other);
-	Ref<BTTask> instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) const;
+	Ref<BTTask> instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root, const Ref<RandomNumberGenerator> &p_rng = Ref<RandomNumberGenerator>()) const;
 
 	BehaviorTree();
 	~BehaviorTree();
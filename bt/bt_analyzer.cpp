@@ -0,0 +1,453 @@
+/**
+ * bt_analyzer.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_analyzer.h"
+
+#include "../blackboard/bb_param/bb_param.h"
+#include "../blackboard/blackboard_plan.h"
+#include "../util/limbo_compat.h"
+#include "tasks/bt_comment.h"
+#include "tasks/composites/bt_dynamic_selector.h"
+#include "tasks/composites/bt_dynamic_sequence.h"
+#include "tasks/composites/bt_probability_selector.h"
+#include "tasks/composites/bt_selector.h"
+#include "tasks/composites/bt_sequence.h"
+#include "tasks/decorators/bt_always_fail.h"
+#include "tasks/decorators/bt_always_succeed.h"
+#include "tasks/decorators/bt_probability.h"
+#include "tasks/decorators/bt_run_limit.h"
+#include "tasks/decorators/bt_subtree.h"
+#include "tasks/utility/bt_call_method.h"
+#include "tasks/utility/bt_evaluate_expression.h"
+#include "tasks/utility/bt_fail.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/error/error_macros.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+#define GET_TICKS_USEC() (OS::get_singleton()->get_ticks_usec())
+
+#endif // ! LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/time.hpp>
+
+#define GET_TICKS_USEC() (Time::get_singleton()->get_ticks_usec())
+
+// Reads the resource type from the file header, like ResourceLoader::get_resource_type() does in the engine.
+// Returns an empty string if the type can't be determined without loading the resource.
+static String _get_resource_type(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return String();
+	}
+	if (p_path.get_extension() == "tres") {
+		// * Header looks like: [gd_resource type="BehaviorTree" load_steps=2 format=3]
+		const String header = f->get_line();
+		if (!header.begins_with("[gd_resource ")) {
+			return String();
+		}
+		const int start = header.find("type=\"");
+		if (start == -1) {
+			return String();
+		}
+		const int end = header.find("\"", start + 6);
+		return end == -1 ? String() : header.substr(start + 6, end - start - 6);
+	}
+
+	// * Binary header: magic, endianness, real size, engine version and format version, followed by the type name.
+	if (f->get_buffer(4).get_string_from_ascii() != "RSRC") {
+		// * Compressed resources (RSCC) are not inspected.
+		return String();
+	}
+	const bool big_endian = f->get_32() != 0;
+	f->set_big_endian(big_endian);
+	f->get_32(); // use_real64
+	f->get_32(); // ver_major
+	f->get_32(); // ver_minor
+	f->get_32(); // ver_format
+	const uint32_t len = f->get_32();
+	if (len == 0 || len > 256 || f->get_error() != OK) {
+		return String();
+	}
+	// * Length includes the null terminator.
+	const PackedByteArray type = f->get_buffer(len);
+	return type.size() == int64_t(len) ? String::utf8((const char *)type.ptr(), len - 1) : String();
+}
+
+#endif // ! LIMBOAI_GDEXTENSION
+
+int64_t BTAnalyzer::_measure_clone_memory(const Ref<BehaviorTree> &p_tree) {
+	const String path = p_tree->get_path();
+	if (!path.is_empty() && clone_memory_cache.has(path)) {
+		return clone_memory_cache[path];
+	}
+
+	// * Relies on the engine's memory counter, which is only maintained in debug builds.
+	int64_t bytes = 0;
+	if (p_tree->get_root_task().is_valid()) {
+		uint64_t mark = GET_MEM_USAGE();
+		Ref<BTTask> inst = p_tree->get_root_task()->clone();
+		// * Other threads may free memory in the meantime, which can't be told apart from the clone.
+		bytes = MAX(int64_t(GET_MEM_USAGE()) - int64_t(mark), int64_t(0));
+	}
+
+	if (!path.is_empty()) {
+		clone_memory_cache[path] = bytes;
+	}
+	return bytes;
+}
+
+void BTAnalyzer::_collect_used_vars_from_value(const Variant &p_value, HashSet<StringName> &r_vars) {
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array arr = p_value;
+		for (int i = 0; i < arr.size(); i++) {
+			_collect_used_vars_from_value(arr[i], r_vars);
+		}
+		return;
+	}
+	if (p_value.get_type() != Variant::OBJECT) {
+		return;
+	}
+
+	Object *obj = p_value;
+	if (obj == nullptr) {
+		return;
+	}
+	BBParam *param = Object::cast_to<BBParam>(obj);
+	if (param) {
+		if (param->get_value_source() == BBParam::BLACKBOARD_VAR && param->get_variable() != StringName()) {
+			r_vars.insert(param->get_variable());
+		}
+		return;
+	}
+	BlackboardPlan *plan = Object::cast_to<BlackboardPlan>(obj);
+	if (plan) {
+		// * Variables mapped to the parent scope.
+		for (const KeyValue<StringName, StringName> &kv : plan->get_parent_scope_mapping()) {
+			if (kv.value != StringName()) {
+				r_vars.insert(kv.value);
+			}
+		}
+	}
+}
+
+// Collects blackboard variable names referenced by the stored properties of an object.
+// Follows the naming convention used by the built-in tasks: string properties ending with "_var" or "variable".
+void BTAnalyzer::_collect_used_vars(Object *p_obj, HashSet<StringName> &r_vars) {
+#ifdef LIMBOAI_MODULE
+	List<PropertyInfo> props;
+	p_obj->get_property_list(&props);
+	for (const PropertyInfo &pi : props) {
+		if (!(pi.usage & PROPERTY_USAGE_STORAGE)) {
+			continue;
+		}
+		const String prop_name = pi.name;
+		const Variant::Type prop_type = pi.type;
+#elif LIMBOAI_GDEXTENSION
+	TypedArray<Dictionary> props = p_obj->get_property_list();
+	for (int i = 0; i < props.size(); i++) {
+		Dictionary prop = props[i];
+		if (!(int(prop["usage"]) & PROPERTY_USAGE_STORAGE)) {
+			continue;
+		}
+		const String prop_name = prop["name"];
+		const Variant::Type prop_type = Variant::Type(int(prop["type"]));
+#endif // LIMBOAI_MODULE & LIMBOAI_GDEXTENSION
+
+		if (prop_type == Variant::STRING || prop_type == Variant::STRING_NAME) {
+			if (prop_name.ends_with("_var") || prop_name.ends_with("variable")) {
+				StringName var = p_obj->get(prop_name);
+				if (var != StringName()) {
+					r_vars.insert(var);
+				}
+			}
+		} else if (prop_type == Variant::OBJECT || prop_type == Variant::ARRAY) {
+			_collect_used_vars_from_value(p_obj->get(prop_name), r_vars);
+		}
+	}
+}
+
+void BTAnalyzer::_add_unreachable(const Ref<BTTask> &p_task, const String &p_path, const String &p_reason, Context &r_ctx) {
+	Dictionary entry;
+	entry["path"] = p_path;
+	entry["task"] = p_task->get_task_name();
+	entry["reason"] = p_reason;
+	r_ctx.unreachable.push_back(entry);
+}
+
+void BTAnalyzer::_check_unreachable(const Ref<BTTask> &p_task, const String &p_path, Context &r_ctx) {
+	if (IS_CLASS(p_task, BTSelector) || IS_CLASS(p_task, BTDynamicSelector)) {
+		bool blocked = false;
+		for (int i = 0; i < p_task->get_child_count(); i++) {
+			Ref<BTTask> child = p_task->get_child(i);
+			if (IS_CLASS(child, BTComment)) {
+				continue;
+			}
+			if (blocked) {
+				_add_unreachable(child, p_path + "/" + itos(i), "Preceded by a task that always succeeds.", r_ctx);
+			} else if (IS_CLASS(child, BTAlwaysSucceed)) {
+				blocked = true;
+			}
+		}
+	} else if (IS_CLASS(p_task, BTSequence) || IS_CLASS(p_task, BTDynamicSequence)) {
+		bool blocked = false;
+		for (int i = 0; i < p_task->get_child_count(); i++) {
+			Ref<BTTask> child = p_task->get_child(i);
+			if (IS_CLASS(child, BTComment)) {
+				continue;
+			}
+			if (blocked) {
+				_add_unreachable(child, p_path + "/" + itos(i), "Preceded by a task that always fails.", r_ctx);
+			} else if (IS_CLASS(child, BTAlwaysFail) || IS_CLASS(child, BTFail)) {
+				blocked = true;
+			}
+		}
+	} else if (IS_CLASS(p_task, BTProbabilitySelector)) {
+		BTProbabilitySelector *sel = Object::cast_to<BTProbabilitySelector>(p_task.ptr());
+		for (int i = 0; i < p_task->get_child_count(); i++) {
+			Ref<BTTask> child = p_task->get_child(i);
+			if (!IS_CLASS(child, BTComment) && sel->get_weight(i) <= 0.0) {
+				_add_unreachable(child, p_path + "/" + itos(i), "Has zero weight.", r_ctx);
+			}
+		}
+	} else if (IS_CLASS(p_task, BTProbability)) {
+		BTProbability *prob = Object::cast_to<BTProbability>(p_task.ptr());
+		if (prob->get_run_chance() <= 0.0 && p_task->get_child_count() > 0) {
+			_add_unreachable(p_task->get_child(0), p_path + "/0", "Run chance is zero.", r_ctx);
+		}
+	} else if (IS_CLASS(p_task, BTRunLimit)) {
+		BTRunLimit *limit = Object::cast_to<BTRunLimit>(p_task.ptr());
+		if (limit->get_run_limit() <= 0 && p_task->get_child_count() > 0) {
+			_add_unreachable(p_task->get_child(0), p_path + "/0", "Run limit is zero.", r_ctx);
+		}
+	}
+}
+
+void BTAnalyzer::_analyze_task(const Ref<BTTask> &p_task, int p_depth, const String &p_path, Context &r_ctx) {
+	if (IS_CLASS(p_task, BTComment)) {
+		// * Comments are removed from tree instances.
+		return;
+	}
+
+	r_ctx.task_count += 1;
+	r_ctx.max_depth = MAX(r_ctx.max_depth, p_depth);
+
+	String task_class = p_task->get_class();
+	Ref<Script> sc = GET_SCRIPT(p_task);
+	if (sc.is_valid()) {
+		r_ctx.script_tasks += 1;
+		if (!sc->get_path().is_empty()) {
+			task_class = sc->get_path();
+		}
+	}
+	r_ctx.task_counts[task_class] = int(r_ctx.task_counts.get(task_class, 0)) + 1;
+
+	if (IS_CLASS(p_task, BTEvaluateExpression)) {
+		r_ctx.expression_evaluations += 1;
+	} else if (IS_CLASS(p_task, BTCallMethod)) {
+		r_ctx.method_calls += 1;
+	}
+
+	_collect_used_vars(p_task.ptr(), r_ctx.used_vars);
+	_check_unreachable(p_task, p_path, r_ctx);
+
+	if (IS_CLASS(p_task, BTSubtree)) {
+		Ref<BehaviorTree> subtree = Object::cast_to<BTSubtree>(p_task.ptr())->get_subtree();
+		if (subtree.is_null()) {
+			r_ctx.errors.push_back(vformat("%s: Subtree is not assigned.", p_path));
+		} else if (r_ctx.tree_stack.find(subtree.ptr()) != -1) {
+			r_ctx.errors.push_back(vformat("%s: Cyclic subtree reference: %s", p_path, subtree->get_path()));
+		} else {
+			const String key = subtree->get_path().is_empty() ? vformat("<unsaved %d>", uint64_t(subtree->get_instance_id())) : subtree->get_path();
+			r_ctx.subtree_uses[key] = int(r_ctx.subtree_uses.get(key, 0)) + 1;
+			// * Each use clones the subtree root upon initialization.
+			r_ctx.clone_memory_bytes += _measure_clone_memory(subtree);
+			_analyze_subtree(subtree, p_depth + 1, p_path + "/0", r_ctx);
+		}
+	}
+
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		_analyze_task(p_task->get_child(i), p_depth + 1, p_path + "/" + itos(i), r_ctx);
+	}
+}
+
+void BTAnalyzer::_analyze_subtree(const Ref<BehaviorTree> &p_tree, int p_depth, const String &p_path, Context &r_ctx) {
+	if (p_tree->get_root_task().is_null()) {
+		r_ctx.errors.push_back(vformat("%s: Behavior tree has no root task: %s", p_path, p_tree->get_path()));
+		return;
+	}
+	r_ctx.tree_stack.push_back(p_tree.ptr());
+	_analyze_task(p_tree->get_root_task(), p_depth, p_path, r_ctx);
+	r_ctx.tree_stack.remove_at(r_ctx.tree_stack.size() - 1);
+}
+
+Dictionary BTAnalyzer::analyze_tree(const Ref<BehaviorTree> &p_tree) {
+	ERR_FAIL_COND_V(p_tree.is_null(), Dictionary());
+
+	Context ctx;
+	ctx.clone_memory_bytes = _measure_clone_memory(p_tree);
+	_analyze_subtree(p_tree, 1, "0", ctx);
+
+	// * Variables used within subtrees are counted as used, since a subtree can access its parent scope.
+	Array unused_vars;
+	Ref<BlackboardPlan> plan = p_tree->get_blackboard_plan();
+	if (plan.is_valid()) {
+		TypedArray<StringName> vars = plan->list_vars();
+		for (int i = 0; i < vars.size(); i++) {
+			StringName var = vars[i];
+			if (!ctx.used_vars.has(var)) {
+				unused_vars.push_back(var);
+			}
+		}
+	}
+
+	Dictionary repeated_subtrees;
+	Array subtree_paths = ctx.subtree_uses.keys();
+	for (int i = 0; i < subtree_paths.size(); i++) {
+		if (int(ctx.subtree_uses[subtree_paths[i]]) > 1) {
+			repeated_subtrees[subtree_paths[i]] = ctx.subtree_uses[subtree_paths[i]];
+		}
+	}
+
+	Dictionary ret;
+	ret["task_count"] = ctx.task_count;
+	ret["task_counts"] = ctx.task_counts;
+	ret["max_depth"] = ctx.max_depth;
+	ret["clone_memory_bytes"] = ctx.clone_memory_bytes;
+	ret["expression_evaluations"] = ctx.expression_evaluations;
+	ret["method_calls"] = ctx.method_calls;
+	ret["script_tasks"] = ctx.script_tasks;
+	ret["unused_vars"] = unused_vars;
+	ret["repeated_subtrees"] = repeated_subtrees;
+	ret["unreachable"] = ctx.unreachable;
+	ret["errors"] = ctx.errors;
+	return ret;
+}
+
+Dictionary BTAnalyzer::analyze_files(const PackedStringArray &p_paths) {
+	uint64_t start = GET_TICKS_USEC();
+	clone_memory_cache.clear();
+
+	// * Load all resources in parallel first; analysis itself runs on the calling thread.
+	LocalVector<bool> requested;
+	requested.resize(p_paths.size());
+	for (int i = 0; i < p_paths.size(); i++) {
+		requested[i] = RESOURCE_LOAD_THREADED_REQUEST(p_paths[i], "BehaviorTree") == OK;
+	}
+	// * Every load must finish before analysis, so that clone memory isn't measured while loader threads allocate.
+	LocalVector<Ref<Resource>> resources;
+	resources.resize(p_paths.size());
+	for (int i = 0; i < p_paths.size(); i++) {
+		resources[i] = requested[i] ? RESOURCE_LOAD_THREADED_GET(p_paths[i]) : RESOURCE_LOAD(p_paths[i], "BehaviorTree");
+	}
+
+	Dictionary trees;
+	int total_tasks = 0;
+	int64_t total_memory = 0;
+	int total_unused_vars = 0;
+	int total_unreachable = 0;
+	int total_errors = 0;
+
+	for (int i = 0; i < p_paths.size(); i++) {
+		const String path = p_paths[i];
+		Ref<Resource> res = resources[i];
+		resources[i].unref();
+		Ref<BehaviorTree> bt = res;
+		if (res.is_valid() && bt.is_null()) {
+			// * Not a behavior tree.
+			continue;
+		}
+
+		Dictionary report;
+		if (bt.is_null()) {
+			Array errors;
+			errors.push_back("Failed to load resource.");
+			report["errors"] = errors;
+		} else {
+			report = analyze_tree(bt);
+			total_tasks += int(report["task_count"]);
+			total_memory += int64_t(report["clone_memory_bytes"]);
+			total_unused_vars += Array(report["unused_vars"]).size();
+			total_unreachable += Array(report["unreachable"]).size();
+		}
+		total_errors += Array(report["errors"]).size();
+		trees[path] = report;
+	}
+
+	Dictionary summary;
+	summary["trees"] = trees.size();
+	summary["task_count"] = total_tasks;
+	summary["clone_memory_bytes"] = total_memory;
+	summary["unused_vars"] = total_unused_vars;
+	summary["unreachable"] = total_unreachable;
+	summary["errors"] = total_errors;
+	summary["analysis_usec"] = int64_t(GET_TICKS_USEC() - start);
+
+	Dictionary ret;
+	ret["trees"] = trees;
+	ret["summary"] = summary;
+	return ret;
+}
+
+Dictionary BTAnalyzer::analyze_project(const String &p_dir) {
+	return analyze_files(find_behavior_trees(p_dir));
+}
+
+void BTAnalyzer::_find_behavior_trees(const String &p_dir, PackedStringArray &r_paths) {
+	Ref<DirAccess> dir = DIR_ACCESS_CREATE();
+	ERR_FAIL_COND_MSG(dir->change_dir(p_dir) != OK, "BTAnalyzer: Failed to open directory: " + p_dir);
+
+	dir->list_dir_begin();
+	String fn = dir->get_next();
+	while (!fn.is_empty()) {
+		if (fn.begins_with(".")) {
+			// * Skip hidden directories such as .godot.
+		} else if (dir->current_is_dir()) {
+			_find_behavior_trees(p_dir.path_join(fn), r_paths);
+		} else {
+			const String path = p_dir.path_join(fn);
+#ifdef LIMBOAI_MODULE
+			if (ResourceLoader::get_resource_type(path) == "BehaviorTree") {
+				r_paths.push_back(path);
+			}
+#elif LIMBOAI_GDEXTENSION
+			// * ResourceLoader doesn't expose resource types in GDExtension, so the type is read from the file header.
+			if ((fn.get_extension() == "tres" || fn.get_extension() == "res") && _get_resource_type(path) == "BehaviorTree") {
+				r_paths.push_back(path);
+			}
+#endif
+		}
+		fn = dir->get_next();
+	}
+	dir->list_dir_end();
+}
+
+PackedStringArray BTAnalyzer::find_behavior_trees(const String &p_dir) const {
+	PackedStringArray paths;
+	_find_behavior_trees(p_dir, paths);
+	return paths;
+}
+
+void BTAnalyzer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("analyze_tree", "behavior_tree"), &BTAnalyzer::analyze_tree);
+	ClassDB::bind_method(D_METHOD("analyze_files", "paths"), &BTAnalyzer::analyze_files);
+	ClassDB::bind_method(D_METHOD("analyze_project", "dir"), &BTAnalyzer::analyze_project, DEFVAL("res://"));
+	ClassDB::bind_method(D_METHOD("find_behavior_trees", "dir"), &BTAnalyzer::find_behavior_trees, DEFVAL("res://"));
+}
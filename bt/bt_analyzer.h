@@ -0,0 +1,78 @@
+/**
+ * bt_analyzer.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_ANALYZER_H
+#define BT_ANALYZER_H
+
+#include "behavior_tree.h"
+#include "tasks/bt_task.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Static analysis of behavior tree resources: structure, instantiation cost and
+// common authoring mistakes. Subtrees are resolved and analyzed as part of their parent tree.
+class BTAnalyzer : public RefCounted {
+	GDCLASS(BTAnalyzer, RefCounted);
+
+private:
+	struct Context {
+		int task_count = 0;
+		int max_depth = 0;
+		int64_t clone_memory_bytes = 0;
+		int expression_evaluations = 0;
+		int method_calls = 0;
+		int script_tasks = 0;
+		Dictionary task_counts;
+		Dictionary subtree_uses;
+		Array unreachable;
+		Array errors;
+		HashSet<StringName> used_vars;
+		LocalVector<const BehaviorTree *> tree_stack;
+	};
+
+	// Net bytes of a root task clone per tree resource path; shared between trees in a single run.
+	HashMap<String, int64_t> clone_memory_cache;
+
+	int64_t _measure_clone_memory(const Ref<BehaviorTree> &p_tree);
+	void _analyze_subtree(const Ref<BehaviorTree> &p_tree, int p_depth, const String &p_path, Context &r_ctx);
+	void _analyze_task(const Ref<BTTask> &p_task, int p_depth, const String &p_path, Context &r_ctx);
+	void _check_unreachable(const Ref<BTTask> &p_task, const String &p_path, Context &r_ctx);
+	void _add_unreachable(const Ref<BTTask> &p_task, const String &p_path, const String &p_reason, Context &r_ctx);
+
+	static void _collect_used_vars(Object *p_obj, HashSet<StringName> &r_vars);
+	static void _collect_used_vars_from_value(const Variant &p_value, HashSet<StringName> &r_vars);
+	static void _find_behavior_trees(const String &p_dir, PackedStringArray &r_paths);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Dictionary analyze_tree(const Ref<BehaviorTree> &p_tree);
+	Dictionary analyze_files(const PackedStringArray &p_paths);
+	Dictionary analyze_project(const String &p_dir = "res://");
+
+	PackedStringArray find_behavior_trees(const String &p_dir = "res://") const;
+};
+
+#endif // BT_ANALYZER_H
@@ -50,14 +50,30 @@ void BTPlayer::_load_tree() {
 	}
 #endif
 	tree_instance.unref();
+	cursor.reset();
 	ERR_FAIL_COND_MSG(!behavior_tree.is_valid(), "BTPlayer: Initialization failed - needs a valid behavior tree.");
 	ERR_FAIL_COND_MSG(!behavior_tree->get_root_task().is_valid(), "BTPlayer: Initialization failed - behavior tree has no valid root task.");
 	Node *agent = GET_NODE(this, agent_node);
 	ERR_FAIL_NULL_MSG(agent, vformat("BTPlayer: Initialization failed - can't get agent with path '%s'.", agent_node));
 	Node *scene_root = get_owner();
 	ERR_FAIL_NULL_MSG(scene_root, "BTPlayer: Initialization failed - can't get scene root (make sure the BTPlayer's owner property is set).");
-	tree_instance = behavior_tree->instantiate(agent, blackboard, scene_root);
 #ifdef DEBUG_ENABLED
+	if (monitor_allocations) {
+		alloc_tracker.reset();
+		alloc_tracker.begin();
+	}
+#endif
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	if (rng_seed != 0) {
+		rng->set_seed(rng_seed);
+	} else {
+		rng->randomize();
+	}
+	tree_instance = behavior_tree->instantiate(agent, blackboard, scene_root, rng);
+#ifdef DEBUG_ENABLED
+	if (monitor_allocations) {
+		alloc_tracker.end_instantiate();
+	}
 	if (IS_DEBUGGER_ACTIVE()) {
 		LimboDebugger::get_singleton()->register_bt_instance(tree_instance, get_path());
 	}
@@ -118,6 +134,11 @@ void BTPlayer::set_active(bool p_active) {
 	set_process_input(active && is_not_editor);
 }
 
+void BTPlayer::set_resume_running_path(bool p_enable) {
+	resume_running_path = p_enable;
+	cursor.reset();
+}
+
 void BTPlayer::update(double p_delta) {
 	if (!tree_instance.is_valid()) {
 		ERR_PRINT_ONCE(vformat("BTPlayer doesn't have a behavior tree with a valid root task to execute (owner: %s)", get_owner()));
@@ -129,8 +150,28 @@ void BTPlayer::update(double p_delta) {
 #endif
 
 	if (active) {
-		last_status = tree_instance->execute(p_delta);
-		emit_signal(LimboStringNames::get_singleton()->updated, last_status);
+#ifdef DEBUG_ENABLED
+		if (monitor_allocations) {
+			alloc_tracker.begin();
+		}
+#endif
+		last_status = resume_running_path ? cursor.execute(tree_instance, p_delta) : tree_instance->execute(p_delta);
+#ifdef DEBUG_ENABLED
+		if (monitor_allocations) {
+			alloc_tracker.end_tick();
+			if (IS_DEBUGGER_ACTIVE() && !alloc_stats_path.is_empty()) {
+				LimboDebugger::get_singleton()->send_alloc_stats(alloc_stats_path, alloc_tracker);
+			}
+		}
+#endif
+		if (HAS_CONNECTIONS(this, LW_NAME(updated))) {
+			emit_signal(LW_NAME(updated), last_status);
+		}
+#ifdef DEBUG_ENABLED
+		if (LimboDebugger::get_singleton()) {
+			LimboDebugger::get_singleton()->notify_tree_updated(this);
+		}
+#endif
 		if (last_status == BTTask::SUCCESS || last_status == BTTask::FAILURE) {
 			emit_signal(LimboStringNames::get_singleton()->behavior_tree_finished, last_status);
 		}
@@ -191,6 +232,43 @@ double BTPlayer::_get_mean_update_time_msec() {
 	return 0.0;
 }
 
+void BTPlayer::_set_monitor_allocations(bool p_monitor_allocations) {
+	monitor_allocations = p_monitor_allocations;
+	alloc_tracker.reset();
+	alloc_stats_path = (monitor_allocations && is_inside_tree()) ? get_path() : NodePath();
+
+	if (!get_owner() && monitor_allocations) {
+		// Don't add custom monitor if not in scene.
+		return;
+	}
+
+	if (monitor_allocations) {
+		_add_alloc_monitor();
+	} else {
+		_remove_alloc_monitor();
+	}
+}
+
+void BTPlayer::_add_alloc_monitor() {
+	if (alloc_monitor_id == StringName()) {
+		alloc_monitor_id = vformat("LimboAI/alloc_bytes_per_tick|%s_%s_%s", get_owner()->get_name(), get_name(),
+				String(itos(get_instance_id())).md5_text().substr(0, 4));
+	}
+	if (!Performance::get_singleton()->has_custom_monitor(alloc_monitor_id)) {
+		PERFORMANCE_ADD_CUSTOM_MONITOR(alloc_monitor_id, callable_mp(this, &BTPlayer::_get_mean_tick_alloc_bytes));
+	}
+}
+
+void BTPlayer::_remove_alloc_monitor() {
+	if (alloc_monitor_id != StringName() && Performance::get_singleton()->has_custom_monitor(alloc_monitor_id)) {
+		Performance::get_singleton()->remove_custom_monitor(alloc_monitor_id);
+	}
+}
+
+double BTPlayer::_get_mean_tick_alloc_bytes() {
+	return alloc_tracker.pop_mean_tick_bytes();
+}
+
 #endif // ! DEBUG_ENABLED
 
 void BTPlayer::_notification(int p_notification) {
@@ -211,6 +289,13 @@ void BTPlayer::_notification(int p_notification) {
 				if (blackboard_plan.is_valid()) {
 					blackboard_plan->populate_blackboard(blackboard, false, this);
 				}
+				if (shared_scope != StringName()) {
+					Ref<Blackboard> top = blackboard->top();
+					Ref<Blackboard> scope = Blackboard::get_shared_scope(shared_scope);
+					if (top != scope) {
+						top->set_parent(scope);
+					}
+				}
 				if (behavior_tree.is_valid()) {
 					_load_tree();
 				}
@@ -227,6 +312,10 @@ void BTPlayer::_notification(int p_notification) {
 			if (monitor_performance) {
 				_add_custom_monitor();
 			}
+			if (monitor_allocations) {
+				alloc_stats_path = get_path();
+				_add_alloc_monitor();
+			}
 #endif // DEBUG_ENABLED
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
@@ -237,6 +326,10 @@ void BTPlayer::_notification(int p_notification) {
 			if (monitor_performance) {
 				_remove_custom_monitor();
 			}
+			if (monitor_allocations) {
+				_remove_alloc_monitor();
+			}
+			alloc_stats_path = NodePath();
 #endif // DEBUG_ENABLED
 
 			if (Engine::get_singleton()->is_editor_hint()) {
@@ -257,8 +350,14 @@ void BTPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_update_mode"), &BTPlayer::get_update_mode);
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &BTPlayer::set_active);
 	ClassDB::bind_method(D_METHOD("get_active"), &BTPlayer::get_active);
+	ClassDB::bind_method(D_METHOD("set_rng_seed", "seed"), &BTPlayer::set_rng_seed);
+	ClassDB::bind_method(D_METHOD("get_rng_seed"), &BTPlayer::get_rng_seed);
 	ClassDB::bind_method(D_METHOD("set_blackboard", "blackboard"), &BTPlayer::set_blackboard);
 	ClassDB::bind_method(D_METHOD("get_blackboard"), &BTPlayer::get_blackboard);
+	ClassDB::bind_method(D_METHOD("set_shared_scope", "name"), &BTPlayer::set_shared_scope);
+	ClassDB::bind_method(D_METHOD("get_shared_scope"), &BTPlayer::get_shared_scope);
+	ClassDB::bind_method(D_METHOD("set_resume_running_path", "enable"), &BTPlayer::set_resume_running_path);
+	ClassDB::bind_method(D_METHOD("get_resume_running_path"), &BTPlayer::get_resume_running_path);
 
 	ClassDB::bind_method(D_METHOD("set_blackboard_plan", "plan"), &BTPlayer::set_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BTPlayer::get_blackboard_plan);
@@ -273,8 +372,11 @@ void BTPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "agent_node"), "set_agent_node", "get_agent_node");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,Manual"), "set_update_mode", "get_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "get_active");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rng_seed"), "set_rng_seed", "get_rng_seed");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_NONE, "Blackboard", 0), "set_blackboard", "get_blackboard");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT | PROPERTY_USAGE_ALWAYS_DUPLICATE), "set_blackboard_plan", "get_blackboard_plan");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "shared_scope"), "set_shared_scope", "get_shared_scope");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "resume_running_path"), "set_resume_running_path", "get_resume_running_path");
 
 	BIND_ENUM_CONSTANT(IDLE);
 	BIND_ENUM_CONSTANT(PHYSICS);
@@ -287,6 +389,9 @@ void BTPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_set_monitor_performance", "enable"), &BTPlayer::_set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("_get_monitor_performance"), &BTPlayer::_get_monitor_performance);
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "_set_monitor_performance", "_get_monitor_performance");
+	ClassDB::bind_method(D_METHOD("_set_monitor_allocations", "enable"), &BTPlayer::_set_monitor_allocations);
+	ClassDB::bind_method(D_METHOD("_get_monitor_allocations"), &BTPlayer::_get_monitor_allocations);
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_allocations"), "_set_monitor_allocations", "_get_monitor_allocations");
 #endif // DEBUG_ENABLED
 }
 
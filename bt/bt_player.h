@@ -14,7 +14,9 @@
 
 #include "../blackboard/blackboard.h"
 #include "../blackboard/blackboard_plan.h"
+#include "../util/limbo_alloc_tracker.h"
 #include "behavior_tree.h"
+#include "bt_resume_cursor.h"
 #include "tasks/bt_task.h"
 
 #ifdef LIMBOAI_MODULE
@@ -41,10 +43,14 @@ private:
 	Ref<BlackboardPlan> blackboard_plan;
 	UpdateMode update_mode = UpdateMode::PHYSICS;
 	bool active = true;
+	int64_t rng_seed = 0;
 	Ref<Blackboard> blackboard;
+	StringName shared_scope;
+	bool resume_running_path = false;
 	int last_status = -1;
 
 	Ref<BTTask> tree_instance;
+	BTResumeCursor cursor;
 
 	void _load_tree();
 	void _update_blackboard_plan();
@@ -70,9 +76,18 @@ public:
 	void set_active(bool p_active);
 	bool get_active() const { return active; }
 
+	void set_rng_seed(int64_t p_seed) { rng_seed = p_seed; }
+	int64_t get_rng_seed() const { return rng_seed; }
+
 	Ref<Blackboard> get_blackboard() const { return blackboard; }
 	void set_blackboard(const Ref<Blackboard> &p_blackboard) { blackboard = p_blackboard; }
 
+	void set_shared_scope(const StringName &p_name) { shared_scope = p_name; }
+	StringName get_shared_scope() const { return shared_scope; }
+
+	void set_resume_running_path(bool p_enable);
+	bool get_resume_running_path() const { return resume_running_path; }
+
 	void update(double p_delta);
 	void restart();
 	int get_last_status() const { return last_status; }
@@ -98,6 +113,23 @@ private:
 
 	double _get_mean_update_time_msec();
 
+private:
+	bool monitor_allocations = false;
+	StringName alloc_monitor_id;
+	LimboAllocTracker alloc_tracker;
+	NodePath alloc_stats_path; // Cached while monitoring, as stats are passed to the debugger on every tick.
+
+	void _set_monitor_allocations(bool p_monitor_allocations);
+	bool _get_monitor_allocations() const { return monitor_allocations; }
+
+	void _add_alloc_monitor();
+	void _remove_alloc_monitor();
+
+	double _get_mean_tick_alloc_bytes();
+
+public:
+	const LimboAllocTracker &get_alloc_tracker() const { return alloc_tracker; }
+
 #endif // DEBUG_ENABLED
 };
 
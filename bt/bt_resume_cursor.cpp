@@ -0,0 +1,88 @@
+/**
+ * bt_resume_cursor.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_resume_cursor.h"
+
+bool BTResumeCursor::_is_transparent(const BTTask *p_task) {
+	// * Scripts can override _tick(), so scripted tasks are never skipped.
+	Ref<Script> sc = GET_SCRIPT(p_task);
+	return sc.is_null() && p_task->_is_transparent();
+}
+
+bool BTResumeCursor::_is_path_valid(const BTTask *p_root) const {
+	if (path.is_empty() || path[0] != p_root) {
+		return false;
+	}
+	// * Tasks could have been aborted outside of the cursor, e.g. by BTPlayer.restart().
+	for (const BTTask *task : path) {
+		if (task->data.status != BT::RUNNING) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BTResumeCursor::_extend_path() {
+	BTTask *task = path[path.size() - 1];
+	while (_is_transparent(task)) {
+		BTTask *next = nullptr;
+		for (const Ref<BTTask> &child : task->data.children) {
+			if (child->data.status == BT::RUNNING) {
+				next = child.ptr();
+				break;
+			}
+		}
+		if (next == nullptr) {
+			return;
+		}
+		path.push_back(next);
+		task = next;
+	}
+}
+
+BT::Status BTResumeCursor::execute(const Ref<BTTask> &p_root, double p_delta) {
+	ERR_FAIL_COND_V(p_root.is_null(), BT::FAILURE);
+
+	if (!_is_path_valid(p_root.ptr())) {
+		path.clear();
+		BT::Status status = p_root->execute(p_delta);
+		if (status == BT::RUNNING) {
+			path.push_back(p_root.ptr());
+			_extend_path();
+		}
+		return status;
+	}
+
+	int idx = path.size() - 1;
+	BT::Status status = path[idx]->execute(p_delta);
+
+	// * Propagate a finished result upward: the parent picks it up from the child's execute() without re-running it.
+	while (status != BT::RUNNING && idx > 0) {
+		BTTask *child = path[idx];
+		child->data.result_pending = true;
+		idx -= 1;
+		status = path[idx]->execute(p_delta);
+		child->data.result_pending = false;
+	}
+
+	// * Skipped ancestors keep their elapsed time as if they were ticked.
+	for (int i = 0; i < idx; i++) {
+		path[i]->data.elapsed += p_delta;
+	}
+
+	if (status == BT::RUNNING) {
+		path.resize(idx + 1);
+		_extend_path();
+	} else {
+		path.clear();
+	}
+	return idx == 0 ? status : BT::RUNNING;
+}
@@ -0,0 +1,45 @@
+/**
+ * bt_resume_cursor.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_RESUME_CURSOR_H
+#define BT_RESUME_CURSOR_H
+
+#include "tasks/bt_task.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+// Executes a tree instance by resuming at the deepest running task instead of walking down from the root on each tick.
+// Only transparent tasks are skipped (see BTTask::_is_transparent()), so tasks that need to see every tick,
+// like dynamic composites and time limits, are still ticked. When the resumed task finishes, its result is
+// propagated upward through its ancestors until one of them keeps running.
+class BTResumeCursor {
+private:
+	// Running path from the root task. All tasks in it are RUNNING, and all but the last one are transparent.
+	LocalVector<BTTask *> path;
+
+	static bool _is_transparent(const BTTask *p_task);
+	bool _is_path_valid(const BTTask *p_root) const;
+	void _extend_path();
+
+public:
+	BT::Status execute(const Ref<BTTask> &p_root, double p_delta);
+	void reset() { path.clear(); }
+
+	int get_depth() const { return path.size(); }
+};
+
+#endif // BT_RESUME_CURSOR_H
@@ -0,0 +1,263 @@
+/**
+ * bt_simulator.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_simulator.h"
+
+#include "../blackboard/blackboard_plan.h"
+#include "../util/limbo_compat.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/error/error_macros.h"
+#include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+
+#define GET_TICKS_USEC() (OS::get_singleton()->get_ticks_usec())
+
+#endif // ! LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+
+#define GET_TICKS_USEC() (Time::get_singleton()->get_ticks_usec())
+
+#endif // ! LIMBOAI_GDEXTENSION
+
+void BTSimulator::set_fixed_delta(double p_delta) {
+	ERR_FAIL_COND_MSG(p_delta < 0.0, "BTSimulator: Fixed delta can't be negative.");
+	fixed_delta = p_delta;
+}
+
+void BTSimulator::spawn_agents(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	ERR_FAIL_COND_MSG(behavior_tree.is_null(), "BTSimulator: Spawning failed - needs a valid behavior tree.");
+	ERR_FAIL_COND_MSG(behavior_tree->get_root_task().is_null(), "BTSimulator: Spawning failed - behavior tree has no valid root task.");
+
+	Ref<BlackboardPlan> plan = behavior_tree->get_blackboard_plan();
+	agents.reserve(agents.size() + p_count);
+
+	for (int n = 0; n < p_count; n++) {
+		uint32_t index = agents.size();
+		AgentData ad;
+
+		if (agent_factory.is_valid()) {
+			Object *obj = agent_factory.call(index);
+			ad.agent = Object::cast_to<Node>(obj);
+			ERR_CONTINUE_MSG(ad.agent == nullptr, "BTSimulator: Agent factory must return a Node.");
+			// Stand-ins that are not part of any hierarchy are owned by the simulator.
+			ad.owns_agent = ad.agent->get_parent() == nullptr && !ad.agent->is_inside_tree();
+		} else {
+			ad.agent = memnew(Node);
+			ad.owns_agent = true;
+		}
+
+		if (plan.is_valid()) {
+			ad.blackboard = plan->create_blackboard(ad.agent);
+		} else {
+			ad.blackboard = Ref<Blackboard>(memnew(Blackboard));
+		}
+		if (!agent_vars.is_empty()) {
+			ad.blackboard->populate_from_dict(agent_vars);
+		}
+
+		Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+		if (rng_seed != 0) {
+			// * Each agent gets its own reproducible stream.
+			rng->set_seed(rng_seed + index);
+		} else {
+			rng->randomize();
+		}
+		ad.tree_instance = behavior_tree->instantiate(ad.agent, ad.blackboard, scene_root, rng);
+
+		if (unlikely(ad.tree_instance.is_null())) {
+			// * Roll back, so that only fully initialized agents occupy slots.
+			if (ad.owns_agent) {
+				memdelete(ad.agent);
+			}
+			ERR_CONTINUE_MSG(true, "BTSimulator: Failed to instantiate behavior tree for agent.");
+		}
+		agents.push_back(ad);
+	}
+}
+
+void BTSimulator::clear() {
+	for (AgentData &ad : agents) {
+		ad.tree_instance.unref();
+		ad.blackboard.unref();
+		if (ad.owns_agent && ad.agent != nullptr) {
+			memdelete(ad.agent);
+		}
+		ad.agent = nullptr;
+	}
+	agents.clear();
+}
+
+void BTSimulator::_simulate_agent(uint32_t p_index, int p_num_ticks) {
+	AgentData &ad = agents[p_index];
+	if (unlikely(ad.tree_instance.is_null())) {
+		return;
+	}
+
+	uint8_t *trace_ptr = nullptr;
+	if (record_trace) {
+		int64_t offset = ad.trace.size();
+		ad.trace.resize(offset + p_num_ticks);
+		trace_ptr = ad.trace.ptrw() + offset;
+	}
+
+	BTTask *root = ad.tree_instance.ptr();
+	for (int t = 0; t < p_num_ticks; t++) {
+		BT::Status status = root->execute(fixed_delta);
+		if (status == BT::SUCCESS) {
+			ad.num_successes += 1;
+		} else if (status == BT::FAILURE) {
+			ad.num_failures += 1;
+		}
+		if (trace_ptr) {
+			trace_ptr[t] = (uint8_t)status;
+		}
+		ad.last_status = status;
+	}
+}
+
+#ifdef LIMBOAI_GDEXTENSION
+void BTSimulator::_simulate_agent_indexed(uint32_t p_index) {
+	_simulate_agent(p_index, ticks_per_agent);
+}
+#endif // LIMBOAI_GDEXTENSION
+
+Dictionary BTSimulator::simulate(int p_num_ticks) {
+	Dictionary stats;
+	ERR_FAIL_COND_V(p_num_ticks < 0, stats);
+	ERR_FAIL_COND_V_MSG(agents.is_empty(), stats, "BTSimulator: No agents to simulate - call spawn_agents() first.");
+
+	uint64_t start = GET_TICKS_USEC();
+
+	if (use_threads && agents.size() > 1) {
+#ifdef LIMBOAI_MODULE
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(
+				this, &BTSimulator::_simulate_agent, p_num_ticks, agents.size(), -1, true, String("BTSimulator"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+#elif LIMBOAI_GDEXTENSION
+		ticks_per_agent = p_num_ticks;
+		int64_t group = WorkerThreadPool::get_singleton()->add_group_task(
+				callable_mp(this, &BTSimulator::_simulate_agent_indexed), agents.size(), -1, true, "BTSimulator");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+#endif
+	} else {
+		for (uint32_t i = 0; i < agents.size(); i++) {
+			_simulate_agent(i, p_num_ticks);
+		}
+	}
+
+	uint64_t elapsed_usec = GET_TICKS_USEC() - start;
+
+	int num_running = 0;
+	int num_succeeded = 0;
+	int num_failed = 0;
+	int64_t num_successes = 0;
+	int64_t num_failures = 0;
+	for (const AgentData &ad : agents) {
+		if (ad.last_status == BT::RUNNING) {
+			num_running += 1;
+		} else if (ad.last_status == BT::SUCCESS) {
+			num_succeeded += 1;
+		} else if (ad.last_status == BT::FAILURE) {
+			num_failed += 1;
+		}
+		num_successes += ad.num_successes;
+		num_failures += ad.num_failures;
+	}
+
+	int64_t agent_ticks = int64_t(agents.size()) * p_num_ticks;
+	stats["agents"] = agents.size();
+	stats["ticks"] = p_num_ticks;
+	stats["agent_ticks"] = agent_ticks;
+	stats["elapsed_usec"] = elapsed_usec;
+	stats["agent_ticks_per_second"] = elapsed_usec > 0 ? double(agent_ticks) * 1000000.0 / double(elapsed_usec) : 0.0;
+	stats["running"] = num_running;
+	stats["succeeded"] = num_succeeded;
+	stats["failed"] = num_failed;
+	stats["total_successes"] = num_successes;
+	stats["total_failures"] = num_failures;
+	return stats;
+}
+
+Node *BTSimulator::get_agent(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)agents.size(), nullptr);
+	return agents[p_index].agent;
+}
+
+Ref<Blackboard> BTSimulator::get_agent_blackboard(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)agents.size(), nullptr);
+	return agents[p_index].blackboard;
+}
+
+Ref<BTTask> BTSimulator::get_agent_tree_instance(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)agents.size(), nullptr);
+	return agents[p_index].tree_instance;
+}
+
+PackedByteArray BTSimulator::get_agent_trace(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)agents.size(), PackedByteArray());
+	return agents[p_index].trace;
+}
+
+BT::Status BTSimulator::get_agent_last_status(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)agents.size(), BT::FRESH);
+	return agents[p_index].last_status;
+}
+
+void BTSimulator::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_behavior_tree", "behavior_tree"), &BTSimulator::set_behavior_tree);
+	ClassDB::bind_method(D_METHOD("get_behavior_tree"), &BTSimulator::get_behavior_tree);
+	ClassDB::bind_method(D_METHOD("set_agent_factory", "factory"), &BTSimulator::set_agent_factory);
+	ClassDB::bind_method(D_METHOD("get_agent_factory"), &BTSimulator::get_agent_factory);
+	ClassDB::bind_method(D_METHOD("set_agent_vars", "vars"), &BTSimulator::set_agent_vars);
+	ClassDB::bind_method(D_METHOD("get_agent_vars"), &BTSimulator::get_agent_vars);
+	ClassDB::bind_method(D_METHOD("set_fixed_delta", "delta"), &BTSimulator::set_fixed_delta);
+	ClassDB::bind_method(D_METHOD("get_fixed_delta"), &BTSimulator::get_fixed_delta);
+	ClassDB::bind_method(D_METHOD("set_use_threads", "enable"), &BTSimulator::set_use_threads);
+	ClassDB::bind_method(D_METHOD("get_use_threads"), &BTSimulator::get_use_threads);
+	ClassDB::bind_method(D_METHOD("set_record_trace", "enable"), &BTSimulator::set_record_trace);
+	ClassDB::bind_method(D_METHOD("get_record_trace"), &BTSimulator::get_record_trace);
+	ClassDB::bind_method(D_METHOD("set_rng_seed", "seed"), &BTSimulator::set_rng_seed);
+	ClassDB::bind_method(D_METHOD("get_rng_seed"), &BTSimulator::get_rng_seed);
+
+	ClassDB::bind_method(D_METHOD("spawn_agents", "count"), &BTSimulator::spawn_agents);
+	ClassDB::bind_method(D_METHOD("clear"), &BTSimulator::clear);
+	ClassDB::bind_method(D_METHOD("simulate", "num_ticks"), &BTSimulator::simulate);
+
+	ClassDB::bind_method(D_METHOD("get_agent_count"), &BTSimulator::get_agent_count);
+	ClassDB::bind_method(D_METHOD("get_agent", "index"), &BTSimulator::get_agent);
+	ClassDB::bind_method(D_METHOD("get_agent_blackboard", "index"), &BTSimulator::get_agent_blackboard);
+	ClassDB::bind_method(D_METHOD("get_agent_tree_instance", "index"), &BTSimulator::get_agent_tree_instance);
+	ClassDB::bind_method(D_METHOD("get_agent_trace", "index"), &BTSimulator::get_agent_trace);
+	ClassDB::bind_method(D_METHOD("get_agent_last_status", "index"), &BTSimulator::get_agent_last_status);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "behavior_tree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_behavior_tree", "get_behavior_tree");
+	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "agent_factory"), "set_agent_factory", "get_agent_factory");
+	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "agent_vars"), "set_agent_vars", "get_agent_vars");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "fixed_delta"), "set_fixed_delta", "get_fixed_delta");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "get_use_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "record_trace"), "set_record_trace", "get_record_trace");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rng_seed"), "set_rng_seed", "get_rng_seed");
+}
+
+BTSimulator::BTSimulator() {
+	scene_root = memnew(Node);
+}
+
+BTSimulator::~BTSimulator() {
+	clear();
+	memdelete(scene_root);
+}
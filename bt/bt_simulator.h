@@ -0,0 +1,106 @@
+/**
+ * bt_simulator.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_SIMULATOR_H
+#define BT_SIMULATOR_H
+
+#include "../blackboard/blackboard.h"
+#include "behavior_tree.h"
+#include "tasks/bt_task.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Headless harness that runs many behavior tree instances with a fixed delta,
+// outside of the SceneTree. Intended for balancing runs and automated tests.
+class BTSimulator : public RefCounted {
+	GDCLASS(BTSimulator, RefCounted);
+
+private:
+	struct AgentData {
+		Node *agent = nullptr;
+		bool owns_agent = false;
+		Ref<Blackboard> blackboard;
+		Ref<BTTask> tree_instance;
+		BT::Status last_status = BT::FRESH;
+		int num_successes = 0;
+		int num_failures = 0;
+		PackedByteArray trace;
+	};
+
+	Ref<BehaviorTree> behavior_tree;
+	Callable agent_factory;
+	Dictionary agent_vars;
+	double fixed_delta = 1.0 / 60.0;
+	bool use_threads = false;
+	bool record_trace = false;
+	int64_t rng_seed = 0;
+
+	Node *scene_root = nullptr;
+	LocalVector<AgentData> agents;
+	int ticks_per_agent = 0;
+
+	void _simulate_agent(uint32_t p_index, int p_num_ticks);
+#ifdef LIMBOAI_GDEXTENSION
+	void _simulate_agent_indexed(uint32_t p_index);
+#endif
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_behavior_tree(const Ref<BehaviorTree> &p_tree) { behavior_tree = p_tree; }
+	Ref<BehaviorTree> get_behavior_tree() const { return behavior_tree; }
+
+	void set_agent_factory(const Callable &p_factory) { agent_factory = p_factory; }
+	Callable get_agent_factory() const { return agent_factory; }
+
+	void set_agent_vars(const Dictionary &p_vars) { agent_vars = p_vars; }
+	Dictionary get_agent_vars() const { return agent_vars; }
+
+	void set_fixed_delta(double p_delta);
+	double get_fixed_delta() const { return fixed_delta; }
+
+	void set_use_threads(bool p_use_threads) { use_threads = p_use_threads; }
+	bool get_use_threads() const { return use_threads; }
+
+	void set_record_trace(bool p_record_trace) { record_trace = p_record_trace; }
+	bool get_record_trace() const { return record_trace; }
+
+	void set_rng_seed(int64_t p_seed) { rng_seed = p_seed; }
+	int64_t get_rng_seed() const { return rng_seed; }
+
+	void spawn_agents(int p_count);
+	void clear();
+	Dictionary simulate(int p_num_ticks);
+
+	int get_agent_count() const { return agents.size(); }
+	Node *get_agent(int p_index) const;
+	Ref<Blackboard> get_agent_blackboard(int p_index) const;
+	Ref<BTTask> get_agent_tree_instance(int p_index) const;
+	PackedByteArray get_agent_trace(int p_index) const;
+	BT::Status get_agent_last_status(int p_index) const;
+
+	BTSimulator();
+	~BTSimulator();
+};
+
+#endif // BT_SIMULATOR_H
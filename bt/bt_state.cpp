@@ -54,7 +54,14 @@ void BTState::_setup() {
 	ERR_FAIL_COND_MSG(behavior_tree.is_null(), "BTState: BehaviorTree is not assigned.");
 	Node *scene_root = get_owner();
 	ERR_FAIL_NULL_MSG(scene_root, "BTState: Initialization failed - can't get scene root (make sure the BTState's owner property is set).");
-	tree_instance = behavior_tree->instantiate(get_agent(), get_blackboard(), scene_root);
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	if (rng_seed != 0) {
+		rng->set_seed(rng_seed);
+	} else {
+		rng->randomize();
+	}
+	tree_instance = behavior_tree->instantiate(get_agent(), get_blackboard(), scene_root, rng);
+	cursor.reset();
 
 #ifdef DEBUG_ENABLED
 	if (tree_instance.is_valid() && IS_DEBUGGER_ACTIVE()) {
@@ -72,6 +79,11 @@ void BTState::_exit() {
 	LimboState::_exit();
 }
 
+void BTState::set_resume_running_path(bool p_enable) {
+	resume_running_path = p_enable;
+	cursor.reset();
+}
+
 void BTState::_update(double p_delta) {
 	VCALL_ARGS(_update, p_delta);
 	if (!is_active()) {
@@ -79,13 +91,42 @@ void BTState::_update(double p_delta) {
 		return;
 	}
 	ERR_FAIL_NULL(tree_instance);
-	int status = tree_instance->execute(p_delta);
+	int status = resume_running_path ? cursor.execute(tree_instance, p_delta) : tree_instance->execute(p_delta);
 	if (status == BTTask::SUCCESS) {
 		get_root()->dispatch(success_event, Variant());
 	} else if (status == BTTask::FAILURE) {
 		get_root()->dispatch(failure_event, Variant());
 	}
-	emit_signal(LW_NAME(updated), p_delta);
+	if (HAS_CONNECTIONS(this, LW_NAME(updated))) {
+		emit_signal(LW_NAME(updated), p_delta);
+	}
+#ifdef DEBUG_ENABLED
+	if (LimboDebugger::get_singleton()) {
+		LimboDebugger::get_singleton()->notify_tree_updated(this);
+	}
+#endif
+}
+
+void BTState::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_u8(tree_instance.is_valid());
+	if (tree_instance.is_valid()) {
+		tree_instance->save_state_to(p_writer);
+	}
+}
+
+void BTState::_load_state(LimboBinaryReader &p_reader) {
+	cursor.reset();
+	bool has_tree = p_reader.get_u8();
+	if (has_tree != tree_instance.is_valid() || (has_tree && tree_instance->load_state_from(p_reader) != OK)) {
+		p_reader.set_error();
+	}
+}
+
+void BTState::_reset_state() {
+	// * An inactive state's tree is always aborted.
+	if (tree_instance.is_valid()) {
+		tree_instance->abort();
+	}
 }
 
 void BTState::_notification(int p_notification) {
@@ -125,9 +166,17 @@ void BTState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_failure_event", "event"), &BTState::set_failure_event);
 	ClassDB::bind_method(D_METHOD("get_failure_event"), &BTState::get_failure_event);
 
+	ClassDB::bind_method(D_METHOD("set_resume_running_path", "enable"), &BTState::set_resume_running_path);
+	ClassDB::bind_method(D_METHOD("get_resume_running_path"), &BTState::get_resume_running_path);
+
+	ClassDB::bind_method(D_METHOD("set_rng_seed", "seed"), &BTState::set_rng_seed);
+	ClassDB::bind_method(D_METHOD("get_rng_seed"), &BTState::get_rng_seed);
+
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "behavior_tree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_behavior_tree", "get_behavior_tree");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "success_event"), "set_success_event", "get_success_event");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "failure_event"), "set_failure_event", "get_failure_event");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "resume_running_path"), "set_resume_running_path", "get_resume_running_path");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rng_seed"), "set_rng_seed", "get_rng_seed");
 }
 
 BTState::BTState() {
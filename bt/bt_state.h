@@ -15,6 +15,7 @@
 #include "../hsm/limbo_state.h"
 
 #include "../bt/behavior_tree.h"
+#include "../bt/bt_resume_cursor.h"
 #include "../bt/tasks/bt_task.h"
 
 class BTState : public LimboState {
@@ -25,6 +26,9 @@ private:
 	Ref<BTTask> tree_instance;
 	StringName success_event;
 	StringName failure_event;
+	bool resume_running_path = false;
+	int64_t rng_seed = 0;
+	BTResumeCursor cursor;
 
 protected:
 	static void _bind_methods();
@@ -38,6 +42,10 @@ protected:
 	virtual void _exit() override;
 	virtual void _update(double p_delta) override;
 
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
+	virtual void _reset_state() override;
+
 public:
 	void set_behavior_tree(const Ref<BehaviorTree> &p_value);
 	Ref<BehaviorTree> get_behavior_tree() const { return behavior_tree; }
@@ -50,6 +58,12 @@ public:
 	void set_failure_event(const StringName &p_failure_event) { failure_event = p_failure_event; }
 	StringName get_failure_event() const { return failure_event; }
 
+	void set_resume_running_path(bool p_enable);
+	bool get_resume_running_path() const { return resume_running_path; }
+
+	void set_rng_seed(int64_t p_seed) { rng_seed = p_seed; }
+	int64_t get_rng_seed() const { return rng_seed; }
+
 	BTState();
 };
 
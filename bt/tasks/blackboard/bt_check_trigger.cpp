@@ -15,6 +15,7 @@
 
 void BTCheckTrigger::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	variable_id = Blackboard::INVALID_VAR_ID;
 	emit_changed();
 }
 
@@ -33,11 +34,20 @@ String BTCheckTrigger::_generate_name() {
 	return "CheckTrigger " + LimboUtility::get_singleton()->decorate_var(variable);
 }
 
+void BTCheckTrigger::_setup() {
+	variable_id = Blackboard::INVALID_VAR_ID;
+	clear_observed_vars();
+	if (get_observer_aborts() != OBSERVER_ABORTS_NONE && variable != StringName()) {
+		add_observed_var(get_var_id(variable, variable_id));
+	}
+}
+
 BT::Status BTCheckTrigger::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BBCheckVar: `variable` is not set.");
-	Variant trigger_value = get_blackboard()->get_var(variable, false);
+	uint32_t var_id = get_var_id(variable, variable_id);
+	Variant trigger_value = get_blackboard()->get_var_by_id(var_id, false);
 	if (trigger_value == Variant(true)) {
-		get_blackboard()->set_var(variable, false);
+		get_blackboard()->set_var_by_id(var_id, false);
 		return SUCCESS;
 	}
 	return FAILURE;
@@ -46,6 +56,9 @@ BT::Status BTCheckTrigger::_tick(double p_delta) {
 void BTCheckTrigger::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_variable", "variable"), &BTCheckTrigger::set_variable);
 	ClassDB::bind_method(D_METHOD("get_variable"), &BTCheckTrigger::get_variable);
+	ClassDB::bind_method(D_METHOD("set_observer_aborts", "observer_aborts"), &BTCheckTrigger::set_observer_aborts);
+	ClassDB::bind_method(D_METHOD("get_observer_aborts"), &BTCheckTrigger::get_observer_aborts);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "variable"), "set_variable", "get_variable");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "observer_aborts", PROPERTY_HINT_ENUM, "None,Self,Lower Priority,Both"), "set_observer_aborts", "get_observer_aborts");
 }
@@ -20,11 +20,13 @@ class BTCheckTrigger : public BTCondition {
 
 private:
 	StringName variable;
+	uint32_t variable_id = Blackboard::INVALID_VAR_ID;
 
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
 public:
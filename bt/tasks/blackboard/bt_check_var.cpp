@@ -13,6 +13,7 @@
 
 void BTCheckVar::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	variable_id = Blackboard::INVALID_VAR_ID;
 	emit_changed();
 }
 
@@ -50,13 +51,25 @@ String BTCheckVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTCheckVar::_setup() {
+	variable_id = Blackboard::INVALID_VAR_ID;
+	clear_observed_vars();
+	if (get_observer_aborts() != OBSERVER_ABORTS_NONE && variable != StringName()) {
+		add_observed_var(get_var_id(variable, variable_id));
+		if (value.is_valid() && value->get_value_source() == BBParam::BLACKBOARD_VAR && value->get_variable() != StringName()) {
+			add_observed_var(get_blackboard()->intern_var(value->get_variable()));
+		}
+	}
+}
+
 BT::Status BTCheckVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTCheckVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTCheckVar: `value` is not set.");
 
-	ERR_FAIL_COND_V_MSG(!get_blackboard()->has_var(variable), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+	uint32_t var_id = get_var_id(variable, variable_id);
+	ERR_FAIL_COND_V_MSG(!get_blackboard()->has_var_by_id(var_id), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
 
-	Variant left_value = get_blackboard()->get_var(variable, Variant());
+	Variant left_value = get_blackboard()->get_var_by_id(var_id, Variant());
 	Variant right_value = value->get_value(get_scene_root(), get_blackboard());
 
 	return LimboUtility::get_singleton()->perform_check(check_type, left_value, right_value) ? SUCCESS : FAILURE;
@@ -69,8 +82,11 @@ void BTCheckVar::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_check_type"), &BTCheckVar::get_check_type);
 	ClassDB::bind_method(D_METHOD("set_value", "value"), &BTCheckVar::set_value);
 	ClassDB::bind_method(D_METHOD("get_value"), &BTCheckVar::get_value);
+	ClassDB::bind_method(D_METHOD("set_observer_aborts", "observer_aborts"), &BTCheckVar::set_observer_aborts);
+	ClassDB::bind_method(D_METHOD("get_observer_aborts"), &BTCheckVar::get_observer_aborts);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "variable"), "set_variable", "get_variable");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "check_type", PROPERTY_HINT_ENUM, "Equal,Less Than,Less Than Or Equal,Greater Than,Greater Than Or Equal,Not Equal"), "set_check_type", "get_check_type");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "value", PROPERTY_HINT_RESOURCE_TYPE, "BBVariant"), "set_value", "get_value");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "observer_aborts", PROPERTY_HINT_ENUM, "None,Self,Lower Priority,Both"), "set_observer_aborts", "get_observer_aborts");
 }
@@ -23,6 +23,7 @@ class BTCheckVar : public BTCondition {
 
 private:
 	StringName variable;
+	uint32_t variable_id = Blackboard::INVALID_VAR_ID;
 	LimboUtility::CheckType check_type = LimboUtility::CheckType::CHECK_EQUAL;
 	Ref<BBVariant> value;
 
@@ -30,6 +31,7 @@ protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
 public:
@@ -31,17 +31,18 @@ BT::Status BTSetVar::_tick(double p_delta) {
 	if (operation == LimboUtility::OPERATION_NONE) {
 		result = right_value;
 	} else if (operation != LimboUtility::OPERATION_NONE) {
-		Variant left_value = get_blackboard()->get_var(variable, error_result);
+		Variant left_value = get_blackboard()->get_var_by_id(get_var_id(variable, variable_id), error_result);
 		ERR_FAIL_COND_V_MSG(left_value == error_result, FAILURE, vformat("BTSetVar: Failed to get \"%s\" blackboard variable. Returning FAILURE.", variable));
 		result = LimboUtility::get_singleton()->perform_operation(operation, left_value, right_value);
 		ERR_FAIL_COND_V_MSG(result == Variant(), FAILURE, "BTSetVar: Operation not valid. Returning FAILURE.");
 	}
-	get_blackboard()->set_var(variable, result);
+	get_blackboard()->set_var_by_id(get_var_id(variable, variable_id), result);
 	return SUCCESS;
 };
 
 void BTSetVar::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	variable_id = Blackboard::INVALID_VAR_ID;
 	emit_changed();
 }
 
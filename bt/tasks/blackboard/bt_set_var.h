@@ -23,6 +23,7 @@ class BTSetVar : public BTAction {
 
 private:
 	StringName variable;
+	uint32_t variable_id = Blackboard::INVALID_VAR_ID;
 	Ref<BBVariant> value;
 	LimboUtility::Operation operation = LimboUtility::OPERATION_NONE;
 
@@ -30,6 +31,7 @@ protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override { variable_id = Blackboard::INVALID_VAR_ID; }
 	virtual Status _tick(double p_delta) override;
 
 public:
@@ -0,0 +1,145 @@
+/**
+ * bt_async_action.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_async_action.h"
+
+//**** Waiting
+
+void BTAsyncAction::_stop_waiting() {
+	if (wait_type == WAIT_SIGNAL) {
+		Callable cb = Callable(this, LW_NAME(_on_awaited_signal));
+		// * Emitter may be freed by now, e.g., a timer that already fired; its connections are gone with it.
+		if (!awaited_signal.is_null() && ObjectDB::get_instance(awaited_signal.get_object_id()) != nullptr &&
+				awaited_signal.is_connected(cb)) {
+			awaited_signal.disconnect(cb);
+		}
+	}
+	wait_type = WAIT_NONE;
+	awaited_signal = Signal();
+	signal_received = false;
+	signal_args = Array();
+}
+
+// Drops waits of the current run, including script coroutines that await it, so they never resume.
+void BTAsyncAction::_cancel() {
+	_stop_waiting();
+#ifdef LIMBOAI_MODULE
+	List<Connection> connections;
+	get_signal_connection_list(LW_NAME(resumed), &connections);
+	for (const Connection &c : connections) {
+		disconnect(LW_NAME(resumed), c.callable);
+	}
+#elif LIMBOAI_GDEXTENSION
+	TypedArray<Dictionary> connections = get_signal_connection_list(LW_NAME(resumed));
+	for (int i = 0; i < connections.size(); i++) {
+		Dictionary c = connections[i];
+		disconnect(LW_NAME(resumed), c["callable"]);
+	}
+#endif
+}
+
+void BTAsyncAction::_resume_now() {
+	int point = resume_point;
+	Array args = signal_args;
+	_stop_waiting();
+	if (point == RESUME_SCRIPT) {
+		emit_signal(LW_NAME(resumed), args);
+	} else {
+		_resume(point, args);
+	}
+}
+
+#ifdef LIMBOAI_MODULE
+void BTAsyncAction::_on_awaited_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	r_error.error = Callable::CallError::CALL_OK;
+#elif LIMBOAI_GDEXTENSION
+void BTAsyncAction::_on_awaited_signal(const Variant **p_args, GDExtensionInt p_argcount, GDExtensionCallError &r_error) {
+	r_error.error = GDEXTENSION_CALL_OK;
+#endif
+	signal_args.resize(p_argcount);
+	for (int i = 0; i < p_argcount; i++) {
+		signal_args[i] = *p_args[i];
+	}
+	// * The action is resumed on its next tick, so it always continues within the tree update.
+	signal_received = true;
+}
+
+void BTAsyncAction::suspend_for(double p_seconds, int p_resume_point) {
+	_stop_waiting();
+	wait_type = WAIT_TIME;
+	resume_point = p_resume_point;
+	resume_time = get_elapsed_time() + p_seconds;
+}
+
+void BTAsyncAction::suspend_until(const Signal &p_signal, int p_resume_point) {
+	_stop_waiting();
+	ERR_FAIL_COND_MSG(p_signal.is_null(), "BTAsyncAction: Can't wait for a null signal.");
+	wait_type = WAIT_SIGNAL;
+	resume_point = p_resume_point;
+	awaited_signal = p_signal;
+	awaited_signal.connect(Callable(this, LW_NAME(_on_awaited_signal)), CONNECT_ONE_SHOT);
+}
+
+Signal BTAsyncAction::wait_seconds(double p_seconds) {
+	suspend_for(p_seconds, RESUME_SCRIPT);
+	return Signal(this, LW_NAME(resumed));
+}
+
+Signal BTAsyncAction::wait_signal(const Signal &p_signal) {
+	suspend_until(p_signal, RESUME_SCRIPT);
+	return Signal(this, LW_NAME(resumed));
+}
+
+void BTAsyncAction::finish(Status p_status) {
+	ERR_FAIL_COND_MSG(p_status != SUCCESS && p_status != FAILURE, "BTAsyncAction: finish() expects SUCCESS or FAILURE.");
+	_stop_waiting();
+	result = p_status;
+}
+
+//**** Task Implementation
+
+void BTAsyncAction::_exit() {
+	_cancel();
+}
+
+BT::Status BTAsyncAction::_tick(double p_delta) {
+	if (get_status() != RUNNING) {
+		// * New run. Waits may be left over if the previous run was aborted and _exit() is overridden by a script.
+		_cancel();
+		result = RUNNING;
+		VCALL_OR_NATIVE(_run);
+	} else if ((wait_type == WAIT_TIME && get_elapsed_time() >= resume_time) || (wait_type == WAIT_SIGNAL && signal_received)) {
+		_resume_now();
+	}
+
+	if (result != RUNNING) {
+		return result;
+	}
+	// * Returning from the action without waiting or calling finish() means it's done.
+	return wait_type == WAIT_NONE ? SUCCESS : RUNNING;
+}
+
+//**** Godot
+
+void BTAsyncAction::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("wait_seconds", "seconds"), &BTAsyncAction::wait_seconds);
+	ClassDB::bind_method(D_METHOD("wait_signal", "signal"), &BTAsyncAction::wait_signal);
+	ClassDB::bind_method(D_METHOD("finish", "status"), &BTAsyncAction::finish);
+	ClassDB::bind_method(D_METHOD("is_suspended"), &BTAsyncAction::is_suspended);
+
+	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "_on_awaited_signal", &BTAsyncAction::_on_awaited_signal, MethodInfo("_on_awaited_signal"));
+
+	ADD_SIGNAL(MethodInfo("resumed", PropertyInfo(Variant::ARRAY, "signal_args")));
+
+#ifdef LIMBOAI_MODULE
+	GDVIRTUAL_BIND(_run);
+#endif // LIMBOAI_MODULE
+}
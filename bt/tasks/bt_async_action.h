@@ -0,0 +1,75 @@
+/**
+ * bt_async_action.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_ASYNC_ACTION_H
+#define BT_ASYNC_ACTION_H
+
+#include "bt_action.h"
+
+class BTAsyncAction : public BTAction {
+	GDCLASS(BTAsyncAction, BTAction);
+
+private:
+	enum WaitType {
+		WAIT_NONE,
+		WAIT_TIME,
+		WAIT_SIGNAL,
+	};
+
+	// Resume point of waits started from scripts: resuming emits the `resumed` signal awaited by the coroutine.
+	static constexpr int RESUME_SCRIPT = -1;
+
+	Status result = RUNNING;
+	WaitType wait_type = WAIT_NONE;
+	int resume_point = 0;
+	double resume_time = 0.0;
+	Signal awaited_signal;
+	bool signal_received = false;
+	Array signal_args;
+
+	void _stop_waiting();
+	void _cancel();
+	void _resume_now();
+
+#ifdef LIMBOAI_MODULE
+	void _on_awaited_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+#elif LIMBOAI_GDEXTENSION
+	void _on_awaited_signal(const Variant **p_args, GDExtensionInt p_argcount, GDExtensionCallError &r_error);
+#endif
+
+protected:
+	static void _bind_methods();
+
+	virtual void _exit() override;
+	virtual Status _tick(double p_delta) override;
+
+	// Starts the action. Is called on the first tick of each run.
+	virtual void _run() {}
+	// Continues the action from a resume point passed to suspend_for() or suspend_until().
+	// p_signal_args holds the arguments of the awaited signal.
+	virtual void _resume(int p_resume_point, const Array &p_signal_args) {}
+
+	void suspend_for(double p_seconds, int p_resume_point);
+	void suspend_until(const Signal &p_signal, int p_resume_point);
+
+#ifdef LIMBOAI_MODULE
+	GDVIRTUAL0(_run);
+#endif // LIMBOAI_MODULE
+
+public:
+	Signal wait_seconds(double p_seconds);
+	Signal wait_signal(const Signal &p_signal);
+	void finish(Status p_status);
+
+	_FORCE_INLINE_ bool is_suspended() const { return wait_type != WAIT_NONE; }
+};
+
+#endif // BT_ASYNC_ACTION_H
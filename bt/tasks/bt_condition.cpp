@@ -11,6 +11,52 @@
 
 #include "bt_condition.h"
 
+//**** Setters / Getters
+
+void BTCondition::set_observer_aborts(ObserverAborts p_observer_aborts) {
+	observer_aborts = p_observer_aborts;
+	emit_changed();
+}
+
+//**** Observers
+
+void BTCondition::clear_observed_vars() {
+	observed_vars.clear();
+	observed_stamps.clear();
+}
+
+void BTCondition::add_observed_var(uint32_t p_var_id) {
+	ERR_FAIL_COND(p_var_id == Blackboard::INVALID_VAR_ID);
+	if (observed_vars.find(p_var_id) != -1) {
+		return;
+	}
+	observed_vars.push_back(p_var_id);
+	// * Stamp is unknown until the first evaluation.
+	observed_stamps.push_back(Blackboard::VAR_STAMP_VOLATILE);
+}
+
+// Returns true if any of the observed variables changed since the last call to update_observed_stamps().
+bool BTCondition::has_observed_changes() const {
+	const Blackboard *bb = get_blackboard().ptr();
+	for (uint32_t i = 0; i < observed_vars.size(); i++) {
+		uint64_t stamp = bb->get_var_stamp_by_id(observed_vars[i]);
+		if (stamp != observed_stamps[i] || stamp == Blackboard::VAR_STAMP_VOLATILE) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Is called by the parent composite after it evaluates this condition.
+void BTCondition::update_observed_stamps() {
+	const Blackboard *bb = get_blackboard().ptr();
+	for (uint32_t i = 0; i < observed_vars.size(); i++) {
+		observed_stamps[i] = bb->get_var_stamp_by_id(observed_vars[i]);
+	}
+}
+
+//**** Task Implementation
+
 PackedStringArray BTCondition::get_configuration_warnings() {
 	PackedStringArray warnings = BTTask::get_configuration_warnings();
 	if (get_child_count_excluding_comments() != 0) {
@@ -18,3 +64,12 @@ PackedStringArray BTCondition::get_configuration_warnings() {
 	}
 	return warnings;
 }
+
+//**** Godot
+
+void BTCondition::_bind_methods() {
+	BIND_ENUM_CONSTANT(OBSERVER_ABORTS_NONE);
+	BIND_ENUM_CONSTANT(OBSERVER_ABORTS_SELF);
+	BIND_ENUM_CONSTANT(OBSERVER_ABORTS_LOWER_PRIORITY);
+	BIND_ENUM_CONSTANT(OBSERVER_ABORTS_BOTH);
+}
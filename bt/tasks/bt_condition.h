@@ -17,11 +17,40 @@
 class BTCondition : public BTTask {
 	GDCLASS(BTCondition, BTTask);
 
+public:
+	enum ObserverAborts : unsigned int {
+		OBSERVER_ABORTS_NONE,
+		OBSERVER_ABORTS_SELF,
+		OBSERVER_ABORTS_LOWER_PRIORITY,
+		OBSERVER_ABORTS_BOTH,
+	};
+
+private:
+	ObserverAborts observer_aborts = OBSERVER_ABORTS_NONE;
+
+	// Blackboard variables observed at runtime, and their stamps at the last evaluation.
+	LocalVector<uint32_t> observed_vars;
+	LocalVector<uint64_t> observed_stamps;
+
 protected:
-	static void _bind_methods() {}
+	static void _bind_methods();
+
+	void clear_observed_vars();
+	void add_observed_var(uint32_t p_var_id);
 
 public:
+	void set_observer_aborts(ObserverAborts p_observer_aborts);
+	ObserverAborts get_observer_aborts() const { return observer_aborts; }
+
+	_FORCE_INLINE_ bool is_aborting_self() const { return observer_aborts & OBSERVER_ABORTS_SELF; }
+	_FORCE_INLINE_ bool is_aborting_lower_priority() const { return observer_aborts & OBSERVER_ABORTS_LOWER_PRIORITY; }
+
+	bool has_observed_changes() const;
+	void update_observed_stamps();
+
 	virtual PackedStringArray get_configuration_warnings() override;
 };
 
+VARIANT_ENUM_CAST(BTCondition::ObserverAborts);
+
 #endif // BT_CONDITION_H
@@ -167,7 +167,12 @@ void BTTask::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node
 	data.agent = p_agent;
 	data.blackboard = p_blackboard;
 	data.scene_root = p_scene_root;
+	if (data.rng.is_null()) {
+		data.rng = Ref<RandomNumberGenerator>(memnew(RandomNumberGenerator));
+		data.rng->randomize();
+	}
 	for (int i = 0; i < data.children.size(); i++) {
+		get_child(i)->set_rng(data.rng);
 		get_child(i)->initialize(p_agent, p_blackboard, p_scene_root);
 	}
 
@@ -238,6 +243,12 @@ Ref<BTTask> BTTask::clone() const {
 }
 
 BT::Status BTTask::execute(double p_delta) {
+	if (unlikely(data.result_pending)) {
+		// * Result was produced by BTResumeCursor, which is now propagating it to the parent.
+		data.result_pending = false;
+		return data.status;
+	}
+
 	if (data.status != RUNNING) {
 		// Reset children status.
 		if (data.status != FRESH) {
@@ -269,6 +280,90 @@ void BTTask::abort() {
 	}
 	data.status = FRESH;
 	data.elapsed = 0.0;
+	data.result_pending = false;
+}
+
+static constexpr uint32_t STATE_MAGIC = 0x5354424C; // "LBTS"
+static constexpr uint8_t STATE_VERSION = 1;
+
+void BTTask::_save_subtree(LimboBinaryWriter &p_writer) const {
+	p_writer.put_u8(uint8_t(data.status));
+	p_writer.put_double(data.elapsed);
+	p_writer.put_u32(data.children.size());
+	uint32_t size_pos = p_writer.reserve_u32();
+	uint32_t payload_start = p_writer.size();
+	_save_state(p_writer);
+	p_writer.patch_u32(size_pos, p_writer.size() - payload_start);
+	for (int i = 0; i < data.children.size(); i++) {
+		data.children[i]->_save_subtree(p_writer);
+	}
+}
+
+bool BTTask::_load_subtree(LimboBinaryReader &p_reader) {
+	uint8_t status = p_reader.get_u8();
+	double elapsed = p_reader.get_double();
+	uint32_t num_children = p_reader.get_u32();
+	uint32_t payload_size = p_reader.get_u32();
+	if (p_reader.has_error() || status > SUCCESS || num_children != uint32_t(data.children.size())) {
+		return false;
+	}
+	data.status = Status(status);
+	data.elapsed = elapsed;
+
+	uint32_t payload_end = p_reader.get_position() + payload_size;
+	_load_state(p_reader);
+	if (p_reader.has_error() || p_reader.get_position() != payload_end) {
+		return false;
+	}
+	for (int i = 0; i < data.children.size(); i++) {
+		if (!data.children[i]->_load_subtree(p_reader)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BTTask::save_state_to(LimboBinaryWriter &p_writer) const {
+	p_writer.put_u32(STATE_MAGIC);
+	p_writer.put_u8(STATE_VERSION);
+	p_writer.put_u8(data.rng.is_valid());
+	if (data.rng.is_valid()) {
+		p_writer.put_u64(data.rng->get_state());
+	}
+	_save_subtree(p_writer);
+}
+
+Error BTTask::load_state_from(LimboBinaryReader &p_reader) {
+	uint32_t magic = p_reader.get_u32();
+	uint8_t version = p_reader.get_u8();
+	ERR_FAIL_COND_V_MSG(magic != STATE_MAGIC || version != STATE_VERSION, ERR_FILE_UNRECOGNIZED, "BTTask: Unrecognized state format.");
+	bool has_rng_state = p_reader.get_u8();
+	uint64_t rng_state = has_rng_state ? p_reader.get_u64() : 0;
+
+	// * Tasks are restored as they are read, so the current state is kept to roll back to if a later task fails.
+	LimboBinaryWriter backup;
+	_save_subtree(backup);
+	if (p_reader.has_error() || !_load_subtree(p_reader)) {
+		LimboBinaryReader backup_reader(backup.ptr(), backup.size());
+		bool restored = _load_subtree(backup_reader);
+		ERR_FAIL_COND_V(!restored, ERR_BUG);
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, "BTTask: State doesn't match the tree structure.");
+	}
+	if (has_rng_state && data.rng.is_valid()) {
+		data.rng->set_state(rng_state);
+	}
+	return OK;
+}
+
+PackedByteArray BTTask::save_state() const {
+	LimboBinaryWriter writer;
+	save_state_to(writer);
+	return writer.to_packed();
+}
+
+Error BTTask::load_state(const PackedByteArray &p_state) {
+	LimboBinaryReader reader(p_state);
+	return load_state_from(reader);
 }
 
 int BTTask::get_child_count_excluding_comments() const {
@@ -286,6 +381,7 @@ void BTTask::add_child(Ref<BTTask> p_child) {
 	p_child->data.parent = this;
 	p_child->data.index = data.children.size();
 	data.children.push_back(p_child);
+	_children_changed();
 	emit_changed();
 }
 
@@ -300,6 +396,7 @@ void BTTask::add_child_at_index(Ref<BTTask> p_child, int p_idx) {
 	for (int i = p_idx + 1; i < data.children.size(); i++) {
 		get_child(i)->data.index = i;
 	}
+	_children_changed();
 	emit_changed();
 }
 
@@ -312,6 +409,7 @@ void BTTask::remove_child(Ref<BTTask> p_child) {
 	for (int i = idx; i < data.children.size(); i++) {
 		get_child(i)->data.index = i;
 	}
+	_children_changed();
 	emit_changed();
 }
 
@@ -323,6 +421,7 @@ void BTTask::remove_child_at_index(int p_idx) {
 	for (int i = p_idx; i < data.children.size(); i++) {
 		get_child(i)->data.index = i;
 	}
+	_children_changed();
 	emit_changed();
 }
 
@@ -414,6 +513,8 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("print_tree", "initial_tabs"), &BTTask::print_tree, Variant(0));
 	ClassDB::bind_method(D_METHOD("get_task_name"), &BTTask::get_task_name);
 	ClassDB::bind_method(D_METHOD("abort"), &BTTask::abort);
+	ClassDB::bind_method(D_METHOD("save_state"), &BTTask::save_state);
+	ClassDB::bind_method(D_METHOD("load_state", "state"), &BTTask::load_state);
 #ifdef TOOLS_ENABLED
 	ClassDB::bind_method(D_METHOD("editor_get_behavior_tree"), &BTTask::editor_get_behavior_tree);
 #endif // TOOLS_ENABLED
@@ -422,6 +523,8 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_agent"), &BTTask::get_agent);
 	ClassDB::bind_method(D_METHOD("set_agent", "agent"), &BTTask::set_agent);
 	ClassDB::bind_method(D_METHOD("get_scene_root"), &BTTask::get_scene_root);
+	ClassDB::bind_method(D_METHOD("get_rng"), &BTTask::get_rng);
+	ClassDB::bind_method(D_METHOD("set_rng", "rng"), &BTTask::set_rng);
 	ClassDB::bind_method(D_METHOD("_get_children"), &BTTask::_get_children);
 	ClassDB::bind_method(D_METHOD("_set_children", "children"), &BTTask::_set_children);
 	ClassDB::bind_method(D_METHOD("get_blackboard"), &BTTask::get_blackboard);
@@ -435,6 +538,7 @@ void BTTask::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "agent", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "set_agent", "get_agent");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene_root", PROPERTY_HINT_NODE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_scene_root");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_RESOURCE_TYPE, "Blackboard", PROPERTY_USAGE_NONE), "", "get_blackboard");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "rng", PROPERTY_HINT_RESOURCE_TYPE, "RandomNumberGenerator", PROPERTY_USAGE_NONE), "set_rng", "get_rng");
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "children", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "_set_children", "_get_children");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "status", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "", "get_status");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "elapsed_time", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "", "get_elapsed_time");
@@ -13,6 +13,7 @@
 #define BT_TASK_H
 
 #include "../../blackboard/blackboard.h"
+#include "../../util/limbo_binary_io.h"
 #include "../../util/limbo_compat.h"
 #include "../../util/limbo_string_names.h"
 #include "../../util/limbo_task_db.h"
@@ -22,6 +23,7 @@
 #include "core/error/error_macros.h"
 #include "core/io/resource.h"
 #include "core/math/math_funcs.h"
+#include "core/math/random_number_generator.h"
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
@@ -36,6 +38,7 @@
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/random_number_generator.hpp>
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/vector.hpp>
@@ -71,6 +74,7 @@ class BTTask : public BT {
 
 private:
 	friend class BehaviorTree;
+	friend class BTResumeCursor;
 
 	// Avoid namespace pollution in the derived classes.
 	struct Data {
@@ -79,10 +83,12 @@ private:
 		Node *agent = nullptr;
 		Node *scene_root = nullptr;
 		Ref<Blackboard> blackboard;
+		Ref<RandomNumberGenerator> rng;
 		BTTask *parent = nullptr;
 		Vector<Ref<BTTask>> children;
 		Status status = FRESH;
 		double elapsed = 0.0;
+		bool result_pending = false; // Task was already executed in this tick by BTResumeCursor.
 		bool display_collapsed = false;
 #ifdef TOOLS_ENABLED
 		ObjectID behavior_tree_id;
@@ -94,6 +100,9 @@ private:
 
 	PackedStringArray _get_configuration_warnings(); // ! Scripts only.
 
+	void _save_subtree(LimboBinaryWriter &p_writer) const;
+	bool _load_subtree(LimboBinaryReader &p_reader);
+
 protected:
 	static void _bind_methods();
 
@@ -103,6 +112,36 @@ protected:
 	virtual void _exit() {}
 	virtual Status _tick(double p_delta) { return FAILURE; }
 
+	// Returns true if, while its running child keeps RUNNING, ticking this task has no effect besides ticking that child
+	// and returning RUNNING. Such tasks are skipped by BTResumeCursor. Must not depend on state that changes while running.
+	virtual bool _is_transparent() const { return false; }
+
+	// Called after a child is added or removed.
+	virtual void _children_changed() {}
+
+	// Runtime state that is not covered by status and elapsed time. Overrides must read exactly what they write.
+	virtual void _save_state(LimboBinaryWriter &p_writer) const {}
+	virtual void _load_state(LimboBinaryReader &p_reader) {}
+
+	// Random numbers for built-in tasks. Drawn from the tree instance's RNG, or from the global RNG if the task is not initialized.
+	_FORCE_INLINE_ double rng_randf() const { return data.rng.is_valid() ? double(data.rng->randf()) : double(RANDF()); }
+	_FORCE_INLINE_ double rng_randf_range(double p_from, double p_to) const { return data.rng.is_valid() ? double(data.rng->randf_range(p_from, p_to)) : double(RAND_RANGE(p_from, p_to)); }
+	_FORCE_INLINE_ int rng_randi_range(int p_from, int p_to) const {
+		if (data.rng.is_valid()) {
+			return data.rng->randi_range(p_from, p_to);
+		}
+		return MIN(p_from + int(RANDF() * (p_to - p_from + 1)), p_to);
+	}
+
+	// Returns a dense ID of a blackboard variable, interned on first use (see Blackboard::intern_var()).
+	// IDs are only valid for the blackboard they came from, so cached IDs should be reset in _setup().
+	_FORCE_INLINE_ uint32_t get_var_id(const StringName &p_name, uint32_t &r_id) {
+		if (unlikely(r_id == Blackboard::INVALID_VAR_ID)) {
+			r_id = data.blackboard->intern_var(p_name);
+		}
+		return r_id;
+	}
+
 #ifdef LIMBOAI_MODULE
 	GDVIRTUAL0RC(String, _generate_name);
 	GDVIRTUAL0(_setup);
@@ -124,6 +163,9 @@ public:
 
 	_FORCE_INLINE_ Node *get_scene_root() const { return data.scene_root; }
 
+	_FORCE_INLINE_ Ref<RandomNumberGenerator> get_rng() const { return data.rng; }
+	void set_rng(const Ref<RandomNumberGenerator> &p_rng) { data.rng = p_rng; }
+
 	void set_display_collapsed(bool p_display_collapsed);
 	bool is_displayed_collapsed() const;
 
@@ -140,6 +182,11 @@ public:
 	Status execute(double p_delta);
 	void abort();
 
+	void save_state_to(LimboBinaryWriter &p_writer) const;
+	Error load_state_from(LimboBinaryReader &p_reader);
+	PackedByteArray save_state() const;
+	Error load_state(const PackedByteArray &p_state);
+
 	_FORCE_INLINE_ Ref<BTTask> get_parent() const { return Ref<BTTask>(data.parent); }
 	_FORCE_INLINE_ bool is_root() const { return data.parent == nullptr; }
 	_FORCE_INLINE_ Ref<Blackboard> get_blackboard() const { return data.blackboard; }
@@ -32,3 +32,11 @@ BT::Status BTDynamicSelector::_tick(double p_delta) {
 	last_running_idx = i;
 	return status;
 }
+
+void BTDynamicSelector::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(last_running_idx);
+}
+
+void BTDynamicSelector::_load_state(LimboBinaryReader &p_reader) {
+	last_running_idx = p_reader.get_i32();
+}
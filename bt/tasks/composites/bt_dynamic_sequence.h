@@ -26,6 +26,9 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
 };
 
 #endif // BT_DYNAMIC_SEQUENCE_H
@@ -62,13 +62,20 @@ bool BTProbabilitySelector::get_abort_on_failure() const {
 	return abort_on_failure;
 }
 
+void BTProbabilitySelector::_setup() {
+	weights_dirty = true;
+}
+
 void BTProbabilitySelector::_enter() {
 	_select_task();
 }
 
 void BTProbabilitySelector::_exit() {
-	failed_tasks.clear();
+	if (has_failures) {
+		_reset_failures();
+	}
 	selected_task.unref();
+	selected_index = -1;
 }
 
 BT::Status BTProbabilitySelector::_tick(double p_delta) {
@@ -78,7 +85,7 @@ BT::Status BTProbabilitySelector::_tick(double p_delta) {
 			if (abort_on_failure) {
 				return FAILURE;
 			}
-			failed_tasks.insert(selected_task);
+			_mark_failed(selected_index);
 			_select_task();
 		} else { // RUNNING or SUCCESS
 			return status;
@@ -88,31 +95,154 @@ BT::Status BTProbabilitySelector::_tick(double p_delta) {
 	return FAILURE;
 }
 
-void BTProbabilitySelector::_select_task() {
-	selected_task.unref();
+void BTProbabilitySelector::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(selected_index);
+	p_writer.put_u32(has_failures ? failed_mask.size() : 0);
+	if (has_failures) {
+		for (uint64_t bits : failed_mask) {
+			p_writer.put_u64(bits);
+		}
+	}
+}
 
-	double remaining_tasks_weight = _get_total_weight();
-	for (const Ref<BTTask> &task : failed_tasks) {
-		remaining_tasks_weight -= _get_weight(task);
+void BTProbabilitySelector::_load_state(LimboBinaryReader &p_reader) {
+	int index = p_reader.get_i32();
+	uint32_t mask_size = p_reader.get_u32();
+	_update_weights();
+	if (index < -1 || index >= get_child_count() || (mask_size != 0 && mask_size != failed_mask.size())) {
+		p_reader.set_error();
+		return;
+	}
+	_reset_failures();
+	for (uint32_t i = 0; i < mask_size; i++) {
+		failed_mask[i] = p_reader.get_u64();
 	}
+	for (int i = 0; i < int(weights.size()); i++) {
+		if (_is_failed(i)) {
+			has_failures = true;
+			_exclude_weight(i);
+		}
+	}
+	selected_index = index;
+	selected_task = index >= 0 ? get_child(index) : Ref<BTTask>();
+}
 
-	double roll = RAND_RANGE(0.0, remaining_tasks_weight);
-	for (int i = 0; i < get_child_count(); i++) {
-		Ref<BTTask> task = get_child(i);
-		if (failed_tasks.has(task)) {
-			continue;
+void BTProbabilitySelector::_update_weights() {
+	int num_children = get_child_count();
+	if (!weights_dirty && int(weights.size()) == num_children) {
+		return;
+	}
+
+	weights.resize(num_children);
+	base_sums.resize(num_children + 1);
+	for (int i = 0; i < num_children; i++) {
+		weights[i] = _get_cached_weight(i);
+	}
+
+	// Build Fenwick tree in O(n).
+	base_sums[0] = 0.0;
+	for (int i = 1; i <= num_children; i++) {
+		base_sums[i] = weights[i - 1];
+	}
+	for (int i = 1; i <= num_children; i++) {
+		int parent = i + (i & -i);
+		if (parent <= num_children) {
+			base_sums[parent] += base_sums[i];
 		}
-		double weight = _get_weight(i);
-		if (weight == 0) {
-			continue;
+	}
+	sums = base_sums;
+	weights_dirty = false;
+
+	if (failed_mask.size() != uint32_t((num_children + 63) / 64)) {
+		failed_mask.resize((num_children + 63) / 64);
+		for (uint64_t &bits : failed_mask) {
+			bits = 0;
+		}
+		has_failures = false;
+	} else if (has_failures) {
+		// * Weights changed while running: re-apply failures to the rebuilt sums.
+		for (int i = 0; i < num_children; i++) {
+			if (_is_failed(i)) {
+				_exclude_weight(i);
+			}
+		}
+	}
+}
+
+void BTProbabilitySelector::_exclude_weight(int p_index) {
+	double weight = weights[p_index];
+	int n = weights.size();
+	for (int i = p_index + 1; i <= n; i += (i & -i)) {
+		sums[i] -= weight;
+	}
+}
+
+void BTProbabilitySelector::_reset_failures() {
+	for (uint32_t i = 0; i < sums.size(); i++) {
+		sums[i] = base_sums[i];
+	}
+	for (uint64_t &bits : failed_mask) {
+		bits = 0;
+	}
+	has_failures = false;
+}
+
+void BTProbabilitySelector::_mark_failed(int p_index) {
+	ERR_FAIL_INDEX(p_index, int(weights.size()));
+	if (_is_failed(p_index)) {
+		return;
+	}
+	failed_mask[p_index >> 6] |= uint64_t(1) << (p_index & 63);
+	has_failures = true;
+	_exclude_weight(p_index);
+}
+
+// Returns the first child index whose cumulative weight exceeds p_roll, or -1.
+int BTProbabilitySelector::_find_index(double p_roll) const {
+	int n = weights.size();
+	int pos = 0;
+	int step = 1;
+	while ((step << 1) <= n) {
+		step <<= 1;
+	}
+	for (; step > 0; step >>= 1) {
+		int next = pos + step;
+		if (next <= n && sums[next] <= p_roll) {
+			pos = next;
+			p_roll -= sums[next];
 		}
-		if (roll > weight) {
-			roll -= weight;
-			continue;
+	}
+	if (pos < n && weights[pos] > 0.0 && !_is_failed(pos)) {
+		return pos;
+	}
+	// Rolled at the upper bound or hit floating-point imprecision: fall back to the last eligible child.
+	for (int i = n - 1; i >= 0; i--) {
+		if (weights[i] > 0.0 && !_is_failed(i)) {
+			return i;
 		}
+	}
+	return -1;
+}
+
+void BTProbabilitySelector::_select_task() {
+	selected_task.unref();
+	selected_index = -1;
+	_update_weights();
+
+	int n = weights.size();
+	double remaining_tasks_weight = 0.0;
+	for (int i = n; i > 0; i -= (i & -i)) {
+		remaining_tasks_weight += sums[i];
+	}
+	if (remaining_tasks_weight <= 0.0) {
+		return;
+	}
 
-		selected_task = task;
-		break;
+	double roll = rng_randf_range(0.0, remaining_tasks_weight);
+	int idx = _find_index(roll);
+	if (idx >= 0) {
+		selected_index = idx;
+		selected_task = get_child(idx);
 	}
 }
 
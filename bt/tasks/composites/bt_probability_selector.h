@@ -18,11 +18,12 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/core_string_names.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
-#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 class BTProbabilitySelector : public BTComposite {
@@ -30,17 +31,37 @@ class BTProbabilitySelector : public BTComposite {
 	TASK_CATEGORY(Composites);
 
 private:
-	HashSet<Ref<BTTask>> failed_tasks;
+	// Child weights are cached in a Fenwick tree (binary indexed tree of partial sums),
+	// so that selection and excluding failed children are O(log n) and don't allocate.
+	// Weights live in the "_weight_" meta. The cache is rebuilt when weights are set through
+	// set_weight() or set_probability(), when children change, and on setup, so editing
+	// the meta directly takes effect only after the tree is initialized again.
+	LocalVector<double> weights;
+	LocalVector<double> base_sums;
+	LocalVector<double> sums;
+	LocalVector<uint64_t> failed_mask;
+	bool weights_dirty = true;
+	bool has_failures = false;
+
 	Ref<BTTask> selected_task;
+	int selected_index = -1;
 	bool abort_on_failure = false;
 
+	void _update_weights();
+	void _reset_failures();
+	void _mark_failed(int p_index);
+	void _exclude_weight(int p_index);
+	_FORCE_INLINE_ bool _is_failed(int p_index) const { return failed_mask[p_index >> 6] & (uint64_t(1) << (p_index & 63)); }
+	int _find_index(double p_roll) const;
 	void _select_task();
 #define SNAME(m_arg) ([]() -> const StringName & { static StringName sname = _scs_create(m_arg, true); return sname; })()
 	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
 	_FORCE_INLINE_ double _get_weight(Ref<BTTask> p_task) const { return p_task->get_meta(LW_NAME(_weight_), 1.0); }
+	_FORCE_INLINE_ double _get_cached_weight(int p_index) const { return IS_CLASS(get_child(p_index), BTComment) ? 0.0 : MAX(_get_weight(p_index), 0.0); }
 	_FORCE_INLINE_ void _set_weight(int p_index, double p_weight) {
 		get_child(p_index)->set_meta(LW_NAME(_weight_), Variant(p_weight));
 		get_child(p_index)->emit_signal(LW_NAME(changed));
+		weights_dirty = true;
 	}
 	_FORCE_INLINE_ double _get_total_weight() const {
 		double total = 0.0;
@@ -55,9 +76,15 @@ private:
 protected:
 	static void _bind_methods();
 
+	virtual void _setup() override;
+	virtual void _children_changed() override { weights_dirty = true; }
 	virtual void _enter() override;
 	virtual void _exit() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_transparent() const override { return true; }
+
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
 
 public:
 	double get_weight(int p_index) const;
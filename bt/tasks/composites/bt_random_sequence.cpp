@@ -13,13 +13,16 @@
 
 void BTRandomSequence::_enter() {
 	last_running_idx = 0;
-	if (indicies.size() != get_child_count()) {
+	if (int(indicies.size()) != get_child_count()) {
 		indicies.resize(get_child_count());
 		for (int i = 0; i < get_child_count(); i++) {
 			indicies[i] = i;
 		}
 	}
-	indicies.shuffle();
+	// Fisher-Yates shuffle using the tree instance's RNG.
+	for (int i = int(indicies.size()) - 1; i > 0; i--) {
+		SWAP(indicies[i], indicies[rng_randi_range(0, i)]);
+	}
 }
 
 BT::Status BTRandomSequence::_tick(double p_delta) {
@@ -33,3 +36,41 @@ BT::Status BTRandomSequence::_tick(double p_delta) {
 	}
 	return status;
 }
+
+void BTRandomSequence::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(last_running_idx);
+	p_writer.put_u32(indicies.size());
+	for (int idx : indicies) {
+		p_writer.put_i32(idx);
+	}
+}
+
+void BTRandomSequence::_load_state(LimboBinaryReader &p_reader) {
+	const int num_children = get_child_count();
+	int running_idx = p_reader.get_i32();
+	uint32_t num_indicies = p_reader.get_u32();
+	// * Indices are either not generated yet, or a permutation of the children.
+	if (p_reader.has_error() || running_idx < 0 || (running_idx >= num_children && running_idx != 0) ||
+			(num_indicies != 0 && num_indicies != uint32_t(num_children)) ||
+			(num_indicies == 0 && get_status() == RUNNING)) {
+		p_reader.set_error();
+		return;
+	}
+	LocalVector<int> order;
+	order.resize(num_indicies);
+	LocalVector<bool> seen;
+	seen.resize(num_indicies);
+	for (uint32_t i = 0; i < num_indicies; i++) {
+		seen[i] = false;
+	}
+	for (int &idx : order) {
+		idx = p_reader.get_i32();
+		if (p_reader.has_error() || idx < 0 || idx >= num_children || seen[idx]) {
+			p_reader.set_error();
+			return;
+		}
+		seen[idx] = true;
+	}
+	last_running_idx = running_idx;
+	indicies = order;
+}
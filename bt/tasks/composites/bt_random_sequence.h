@@ -14,19 +14,31 @@
 
 #include "../bt_composite.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
 class BTRandomSequence : public BTComposite {
 	GDCLASS(BTRandomSequence, BTComposite);
 	TASK_CATEGORY(Composites);
 
 private:
 	int last_running_idx = 0;
-	Array indicies;
+	LocalVector<int> indicies;
 
 protected:
 	static void _bind_methods() {}
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_transparent() const override { return true; }
+
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
 };
 
 #endif // BT_RANDOM_SEQUENCE_H
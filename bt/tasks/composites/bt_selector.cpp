@@ -11,14 +11,81 @@
 
 #include "bt_selector.h"
 
+#include "../bt_condition.h"
+
+void BTSelector::_setup() {
+	// * A branch is guarded by a condition child, or by the conditions its composite starts with.
+	observers.clear();
+	for (int i = 0; i < get_child_count(); i++) {
+		Ref<BTTask> child = get_child(i);
+		BTCondition *cond = Object::cast_to<BTCondition>(child.ptr());
+		if (cond) {
+			if (cond->is_aborting_lower_priority()) {
+				observers.push_back({ i, cond });
+			}
+			continue;
+		}
+		if (!IS_CLASS(child, BTComposite)) {
+			continue;
+		}
+		for (int j = 0; j < child->get_child_count(); j++) {
+			cond = Object::cast_to<BTCondition>(child->get_child(j).ptr());
+			if (cond == nullptr) {
+				break;
+			}
+			if (cond->is_aborting_lower_priority()) {
+				observers.push_back({ i, cond });
+			}
+		}
+	}
+}
+
+void BTSelector::_update_observer_stamps(int p_child_idx) {
+	for (const Observer &obs : observers) {
+		if (obs.child_idx == p_child_idx) {
+			obs.condition->update_observed_stamps();
+		}
+	}
+}
+
+// Returns index of the first branch in [p_from, p_to) with changes in observed variables, or -1.
+int BTSelector::_find_changed_branch(int p_from, int p_to) const {
+	for (const Observer &obs : observers) {
+		if (obs.child_idx >= p_to) {
+			break;
+		}
+		if (obs.child_idx >= p_from && obs.condition->has_observed_changes()) {
+			return obs.child_idx;
+		}
+	}
+	return -1;
+}
+
 void BTSelector::_enter() {
 	last_running_idx = 0;
 }
 
 BT::Status BTSelector::_tick(double p_delta) {
 	Status status = FAILURE;
+
+	// * Observer aborts: Re-evaluate higher priority branches only if their observed variables have changed.
+	for (int i = _find_changed_branch(0, last_running_idx); i != -1; i = _find_changed_branch(i + 1, last_running_idx)) {
+		status = get_child(i)->execute(p_delta);
+		_update_observer_stamps(i);
+		if (status != FAILURE) {
+			if (get_child(last_running_idx)->get_status() == RUNNING) {
+				get_child(last_running_idx)->abort();
+			}
+			last_running_idx = i;
+			return status;
+		}
+	}
+
 	for (int i = last_running_idx; i < get_child_count(); i++) {
 		status = get_child(i)->execute(p_delta);
+		if (!observers.is_empty()) {
+			_update_observer_stamps(i);
+		}
 		if (status != FAILURE) {
 			last_running_idx = i;
 			break;
@@ -26,3 +93,11 @@ BT::Status BTSelector::_tick(double p_delta) {
 	}
 	return status;
 }
+
+void BTSelector::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(last_running_idx);
+}
+
+void BTSelector::_load_state(LimboBinaryReader &p_reader) {
+	last_running_idx = p_reader.get_i32();
+}
@@ -14,6 +14,8 @@
 
 #include "../bt_composite.h"
 
+class BTCondition;
+
 class BTSelector : public BTComposite {
 	GDCLASS(BTSelector, BTComposite);
 	TASK_CATEGORY(Composites);
@@ -21,11 +23,26 @@ class BTSelector : public BTComposite {
 private:
 	int last_running_idx = 0;
 
+	// Conditions that abort lower priority branches, in the order of the child branches they guard.
+	struct Observer {
+		int child_idx = 0;
+		BTCondition *condition = nullptr;
+	};
+	LocalVector<Observer> observers;
+
+	void _update_observer_stamps(int p_child_idx);
+	int _find_changed_branch(int p_from, int p_to) const;
+
 protected:
 	static void _bind_methods() {}
 
+	virtual void _setup() override;
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_transparent() const override { return observers.is_empty(); }
+
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
 };
 
 #endif // BT_SELECTOR_H
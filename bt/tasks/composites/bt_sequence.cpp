@@ -11,14 +11,54 @@
 
 #include "bt_sequence.h"
 
+#include "../bt_condition.h"
+
+void BTSequence::_setup() {
+	observers.clear();
+	for (int i = 0; i < get_child_count(); i++) {
+		BTCondition *cond = Object::cast_to<BTCondition>(get_child(i).ptr());
+		if (cond && cond->is_aborting_self()) {
+			observers.push_back({ i, cond });
+		}
+	}
+}
+
+void BTSequence::_update_observer_stamps(int p_child_idx) {
+	for (const Observer &obs : observers) {
+		if (obs.child_idx == p_child_idx) {
+			obs.condition->update_observed_stamps();
+			return;
+		}
+	}
+}
+
 void BTSequence::_enter() {
 	last_running_idx = 0;
 }
 
 BT::Status BTSequence::_tick(double p_delta) {
+	// * Observer aborts: Re-evaluate conditions that already passed only if their observed variables have changed.
+	for (const Observer &obs : observers) {
+		if (obs.child_idx >= last_running_idx) {
+			break;
+		}
+		if (!obs.condition->has_observed_changes()) {
+			continue;
+		}
+		Status status = obs.condition->execute(p_delta);
+		obs.condition->update_observed_stamps();
+		if (status == FAILURE) {
+			get_child(last_running_idx)->abort();
+			return FAILURE;
+		}
+	}
+
 	Status status = SUCCESS;
 	for (int i = last_running_idx; i < get_child_count(); i++) {
 		status = get_child(i)->execute(p_delta);
+		if (!observers.is_empty()) {
+			_update_observer_stamps(i);
+		}
 		if (status != SUCCESS) {
 			last_running_idx = i;
 			break;
@@ -26,3 +66,11 @@ BT::Status BTSequence::_tick(double p_delta) {
 	}
 	return status;
 }
+
+void BTSequence::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(last_running_idx);
+}
+
+void BTSequence::_load_state(LimboBinaryReader &p_reader) {
+	last_running_idx = p_reader.get_i32();
+}
@@ -14,6 +14,8 @@
 
 #include "../bt_composite.h"
 
+class BTCondition;
+
 class BTSequence : public BTComposite {
 	GDCLASS(BTSequence, BTComposite);
 	TASK_CATEGORY(Composites);
@@ -21,11 +23,25 @@ class BTSequence : public BTComposite {
 private:
 	int last_running_idx = 0;
 
+	// Condition children that abort this sequence when their observed variables change, and the condition no longer holds.
+	struct Observer {
+		int child_idx = 0;
+		BTCondition *condition = nullptr;
+	};
+	LocalVector<Observer> observers;
+
+	void _update_observer_stamps(int p_child_idx);
+
 protected:
 	static void _bind_methods() {}
 
+	virtual void _setup() override;
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_transparent() const override { return observers.is_empty(); }
+
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
 };
 
 #endif // BT_SEQUENCE_H
@@ -0,0 +1,99 @@
+/**
+ * bt_agent_view.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_agent_view.h"
+
+#include "../../../blackboard/blackboard.h"
+
+//**** Setters / Getters
+
+void BTAgentView::set_properties(const PackedStringArray &p_properties) {
+	properties = p_properties;
+	emit_changed();
+}
+
+//**** Task Implementation
+
+PackedStringArray BTAgentView::get_configuration_warnings() {
+	PackedStringArray warnings = BTDecorator::get_configuration_warnings();
+	if (properties.is_empty()) {
+		warnings.append("`properties` should be assigned.");
+	}
+	return warnings;
+}
+
+String BTAgentView::_generate_name() {
+	if (properties.is_empty()) {
+		return "AgentView ???";
+	}
+	return "AgentView " + String(", ").join(properties);
+}
+
+void BTAgentView::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) {
+	ERR_FAIL_COND(p_agent == nullptr);
+	ERR_FAIL_COND(p_blackboard == nullptr);
+
+	// * Mirrored properties live in their own scope, so they don't shadow variables in the agent's blackboard.
+	// * As in any scope, variables assigned by the child are stored here and shadow those of the agent's blackboard.
+	Ref<Blackboard> bb = Ref<Blackboard>(memnew(Blackboard));
+	bb->set_parent(p_blackboard);
+	BTDecorator::initialize(p_agent, bb, p_scene_root);
+}
+
+void BTAgentView::_setup() {
+	entries.clear();
+	entries.resize(properties.size());
+	for (int i = 0; i < properties.size(); i++) {
+		Entry &e = entries[i];
+		e.accessor.setup(get_agent(), properties[i]);
+		e.var_id = get_blackboard()->intern_var(properties[i]);
+	}
+}
+
+void BTAgentView::_pull() {
+	Node *agent = get_agent();
+	for (Entry &e : entries) {
+		e.value = e.accessor.get(agent, &e.valid);
+		if (e.valid) {
+			get_blackboard()->set_var_by_id(e.var_id, e.value);
+		}
+	}
+}
+
+void BTAgentView::_push() {
+	Node *agent = get_agent();
+	for (Entry &e : entries) {
+		if (!e.valid) {
+			continue;
+		}
+		Variant value = get_blackboard()->get_var_by_id(e.var_id, e.value, false);
+		if (value != e.value) {
+			e.accessor.set(agent, value);
+		}
+	}
+}
+
+BT::Status BTAgentView::_tick(double p_delta) {
+	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator has no child.");
+	_pull();
+	Status status = get_child(0)->execute(p_delta);
+	_push();
+	return status;
+}
+
+//**** Godot
+
+void BTAgentView::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_properties", "properties"), &BTAgentView::set_properties);
+	ClassDB::bind_method(D_METHOD("get_properties"), &BTAgentView::get_properties);
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "properties"), "set_properties", "get_properties");
+}
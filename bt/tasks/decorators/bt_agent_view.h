@@ -0,0 +1,60 @@
+/**
+ * bt_agent_view.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_AGENT_VIEW_H
+#define BT_AGENT_VIEW_H
+
+#include "../bt_decorator.h"
+
+#include "../../../util/limbo_property_accessor.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+class BTAgentView : public BTDecorator {
+	GDCLASS(BTAgentView, BTDecorator);
+	TASK_CATEGORY(Decorators);
+
+private:
+	struct Entry {
+		LimboPropertyAccessor accessor;
+		uint32_t var_id = Blackboard::INVALID_VAR_ID;
+		Variant value;
+		bool valid = false;
+	};
+
+	PackedStringArray properties;
+	LocalVector<Entry> entries;
+
+	void _pull();
+	void _push();
+
+protected:
+	static void _bind_methods();
+
+	virtual String _generate_name() override;
+	virtual void _setup() override;
+	virtual Status _tick(double p_delta) override;
+
+public:
+	void set_properties(const PackedStringArray &p_properties);
+	PackedStringArray get_properties() const { return properties; }
+
+	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) override;
+	virtual PackedStringArray get_configuration_warnings() override;
+};
+
+#endif // BT_AGENT_VIEW_H
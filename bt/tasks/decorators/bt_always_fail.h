@@ -22,6 +22,7 @@ protected:
 	static void _bind_methods() {}
 
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_transparent() const override { return true; }
 };
 
 #endif // BT_ALWAYS_FAIL_H
@@ -43,6 +43,7 @@ void BTCooldown::set_trigger_on_failure(bool p_value) {
 
 void BTCooldown::set_cooldown_state_var(const StringName &p_value) {
 	cooldown_state_var = p_value;
+	cooldown_state_id = Blackboard::INVALID_VAR_ID;
 	emit_changed();
 }
 
@@ -54,9 +55,11 @@ String BTCooldown::_generate_name() {
 
 void BTCooldown::_setup() {
 	if (cooldown_state_var == StringName()) {
-		cooldown_state_var = vformat("cooldown_%d", rand());
+		// * Unique within the process, and doesn't consume values from the tree's RNG stream.
+		cooldown_state_var = "cooldown_" + String::num_uint64(uint64_t(get_instance_id()));
 	}
-	get_blackboard()->set_var(cooldown_state_var, false);
+	cooldown_state_id = get_blackboard()->intern_var(cooldown_state_var);
+	get_blackboard()->set_var_by_id(cooldown_state_id, false);
 	if (start_cooled) {
 		_chill();
 	}
@@ -64,7 +67,7 @@ void BTCooldown::_setup() {
 
 BT::Status BTCooldown::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator has no child.");
-	if (get_blackboard()->get_var(cooldown_state_var, true)) {
+	if (get_blackboard()->get_var_by_id(get_var_id(cooldown_state_var, cooldown_state_id), true)) {
 		return FAILURE;
 	}
 	Status status = get_child(0)->execute(p_delta);
@@ -74,8 +77,25 @@ BT::Status BTCooldown::_tick(double p_delta) {
 	return status;
 }
 
+void BTCooldown::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_double(timer.is_valid() ? double(timer->get_time_left()) : 0.0);
+}
+
+void BTCooldown::_load_state(LimboBinaryReader &p_reader) {
+	double time_left = p_reader.get_double();
+	if (time_left > 0.0) {
+		_chill();
+		if (timer.is_valid()) {
+			timer->set_time_left(time_left);
+		}
+	} else if (timer.is_valid()) {
+		timer->disconnect(LW_NAME(timeout), callable_mp(this, &BTCooldown::_on_timeout));
+		_on_timeout();
+	}
+}
+
 void BTCooldown::_chill() {
-	get_blackboard()->set_var(cooldown_state_var, true);
+	get_blackboard()->set_var_by_id(get_var_id(cooldown_state_var, cooldown_state_id), true);
 	if (timer.is_valid()) {
 		timer->set_time_left(duration);
 	} else {
@@ -86,7 +106,7 @@ void BTCooldown::_chill() {
 }
 
 void BTCooldown::_on_timeout() {
-	get_blackboard()->set_var(cooldown_state_var, false);
+	get_blackboard()->set_var_by_id(get_var_id(cooldown_state_var, cooldown_state_id), false);
 	timer.unref();
 }
 
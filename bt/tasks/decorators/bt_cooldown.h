@@ -32,6 +32,7 @@ private:
 	bool start_cooled = false;
 	bool trigger_on_failure = false;
 	StringName cooldown_state_var = "";
+	uint32_t cooldown_state_id = Blackboard::INVALID_VAR_ID;
 
 	Ref<SceneTreeTimer> timer = nullptr;
 
@@ -45,6 +46,9 @@ protected:
 	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
+
 public:
 	void set_duration(double p_value);
 	double get_duration() const { return duration; }
@@ -26,6 +26,7 @@ protected:
 
 	virtual String _generate_name() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_transparent() const override { return true; }
 
 public:
 	void set_seconds(double p_value);
@@ -67,6 +67,14 @@ BT::Status BTForEach::_tick(double p_delta) {
 	}
 }
 
+void BTForEach::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(current_idx);
+}
+
+void BTForEach::_load_state(LimboBinaryReader &p_reader) {
+	current_idx = p_reader.get_i32();
+}
+
 //**** Godot
 
 void BTForEach::_bind_methods() {
@@ -31,6 +31,9 @@ protected:
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
 
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
+
 public:
 	void set_array_var(const StringName &p_value);
 	StringName get_array_var() const { return array_var; }
@@ -58,6 +58,23 @@ BT::Status BTNewScope::_tick(double p_delta) {
 	return get_child(0)->execute(p_delta);
 }
 
+void BTNewScope::_save_state(LimboBinaryWriter &p_writer) const {
+	// * Only the local scope is saved; parent scopes are saved by their owners.
+	if (get_blackboard().is_valid()) {
+		get_blackboard()->save_state_to(p_writer);
+	} else {
+		p_writer.put_u32(0);
+	}
+}
+
+void BTNewScope::_load_state(LimboBinaryReader &p_reader) {
+	if (get_blackboard().is_valid()) {
+		get_blackboard()->load_state_from(p_reader);
+	} else if (p_reader.get_u32() != 0) {
+		p_reader.set_error();
+	}
+}
+
 void BTNewScope::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_blackboard_plan", "plan"), &BTNewScope::set_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BTNewScope::get_blackboard_plan);
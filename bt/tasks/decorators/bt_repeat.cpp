@@ -37,6 +37,14 @@ BT::Status BTRepeat::_tick(double p_delta) {
 	}
 }
 
+void BTRepeat::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(cur_iteration);
+}
+
+void BTRepeat::_load_state(LimboBinaryReader &p_reader) {
+	cur_iteration = p_reader.get_i32();
+}
+
 void BTRepeat::set_forever(bool p_forever) {
 	forever = p_forever;
 	notify_property_list_changed();
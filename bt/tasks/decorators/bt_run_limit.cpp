@@ -39,6 +39,14 @@ BT::Status BTRunLimit::_tick(double p_delta) {
 	return child_status;
 }
 
+void BTRunLimit::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(num_runs);
+}
+
+void BTRunLimit::_load_state(LimboBinaryReader &p_reader) {
+	num_runs = p_reader.get_i32();
+}
+
 void BTRunLimit::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_run_limit", "max_runs"), &BTRunLimit::set_run_limit);
 	ClassDB::bind_method(D_METHOD("get_run_limit"), &BTRunLimit::get_run_limit);
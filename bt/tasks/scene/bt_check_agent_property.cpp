@@ -13,6 +13,7 @@
 
 void BTCheckAgentProperty::set_property(StringName p_prop) {
 	property = p_prop;
+	accessor.setup(nullptr, property);
 	emit_changed();
 }
 
@@ -56,10 +57,10 @@ BT::Status BTCheckAgentProperty::_tick(double p_delta) {
 
 #ifdef LIMBOAI_MODULE
 	bool r_valid;
-	Variant left_value = get_agent()->get(property, &r_valid);
+	Variant left_value = accessor.get(get_agent(), &r_valid);
 	ERR_FAIL_COND_V_MSG(r_valid == false, FAILURE, vformat("BTCheckAgentProperty: Agent has no property named \"%s\"", property));
 #elif LIMBOAI_GDEXTENSION
-	Variant left_value = get_agent()->get(property);
+	Variant left_value = accessor.get(get_agent());
 #endif
 
 	Variant right_value = value->get_value(get_scene_root(), get_blackboard());
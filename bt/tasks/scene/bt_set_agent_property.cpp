@@ -13,6 +13,7 @@
 
 void BTSetAgentProperty::set_property(StringName p_prop) {
 	property = p_prop;
+	accessor.setup(nullptr, property);
 	emit_changed();
 }
 
@@ -62,20 +63,20 @@ BT::Status BTSetAgentProperty::_tick(double p_delta) {
 		result = right_value;
 	} else {
 #ifdef LIMBOAI_MODULE
-		Variant left_value = get_agent()->get(property, &r_valid);
+		Variant left_value = accessor.get(get_agent(), &r_valid);
 		ERR_FAIL_COND_V_MSG(!r_valid, FAILURE, vformat("BTSetAgentProperty: Failed to get agent's \"%s\" property. Returning FAILURE.", property));
 #elif LIMBOAI_GDEXTENSION
-		Variant left_value = get_agent()->get(property);
+		Variant left_value = accessor.get(get_agent());
 #endif
 		result = LimboUtility::get_singleton()->perform_operation(operation, left_value, right_value);
 		ERR_FAIL_COND_V_MSG(result == Variant(), FAILURE, "BTSetAgentProperty: Operation not valid. Returning FAILURE.");
 	}
 
 #ifdef LIMBOAI_MODULE
-	get_agent()->set(property, result, &r_valid);
+	accessor.set(get_agent(), result, &r_valid);
 	ERR_FAIL_COND_V_MSG(!r_valid, FAILURE, vformat("BTSetAgentProperty: Couldn't set property \"%s\" with value \"%s\"", property, result));
 #elif LIMBOAI_GDEXTENSION
-	get_agent()->set(property, result);
+	accessor.set(get_agent(), result);
 #endif
 	return SUCCESS;
 }
@@ -15,6 +15,7 @@
 #include "../bt_action.h"
 
 #include "../../../blackboard/bb_param/bb_variant.h"
+#include "../../../util/limbo_property_accessor.h"
 #include "../../../util/limbo_utility.h"
 
 class BTSetAgentProperty : public BTAction {
@@ -23,6 +24,7 @@ class BTSetAgentProperty : public BTAction {
 
 private:
 	StringName property;
+	LimboPropertyAccessor accessor;
 	Ref<BBVariant> value;
 	LimboUtility::Operation operation = LimboUtility::OPERATION_NONE;
 
@@ -30,6 +32,7 @@ protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override { accessor.setup(get_agent(), property); }
 	virtual Status _tick(double p_delta) override;
 
 public:
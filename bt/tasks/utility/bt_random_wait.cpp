@@ -20,7 +20,7 @@ String BTRandomWait::_generate_name() {
 }
 
 void BTRandomWait::_enter() {
-	duration = RAND_RANGE(min_duration, max_duration);
+	duration = rng_randf_range(min_duration, max_duration);
 }
 
 BT::Status BTRandomWait::_tick(double p_delta) {
@@ -31,6 +31,14 @@ BT::Status BTRandomWait::_tick(double p_delta) {
 	}
 }
 
+void BTRandomWait::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_double(duration);
+}
+
+void BTRandomWait::_load_state(LimboBinaryReader &p_reader) {
+	duration = p_reader.get_double();
+}
+
 void BTRandomWait::set_min_duration(double p_max_duration) {
 	min_duration = p_max_duration;
 	if (max_duration < min_duration) {
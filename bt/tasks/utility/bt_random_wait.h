@@ -31,6 +31,9 @@ protected:
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
 
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
+
 public:
 	void set_min_duration(double p_max_duration);
 	double get_min_duration() const { return min_duration; }
@@ -28,6 +28,14 @@ BT::Status BTWaitTicks::_tick(double p_delta) {
 	}
 }
 
+void BTWaitTicks::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(num_passed);
+}
+
+void BTWaitTicks::_load_state(LimboBinaryReader &p_reader) {
+	num_passed = p_reader.get_i32();
+}
+
 void BTWaitTicks::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_num_ticks", "num_ticks"), &BTWaitTicks::set_num_ticks);
 	ClassDB::bind_method(D_METHOD("get_num_ticks"), &BTWaitTicks::get_num_ticks);
@@ -30,6 +30,9 @@ protected:
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
 
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
+
 public:
 	void set_num_ticks(int p_value) {
 		num_ticks = p_value;
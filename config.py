@@ -64,8 +64,11 @@ def get_doc_classes():
         "BlackboardPlan",
         "BT",
         "BTAction",
+        "BTAgentView",
         "BTAlwaysFail",
         "BTAlwaysSucceed",
+        "BTAnalyzer",
+        "BTAsyncAction",
         "BTAwaitAnimation",
         "BTCallMethod",
         "BTEvaluateExpression",
@@ -102,6 +105,7 @@ def get_doc_classes():
         "BTSequence",
         "BTSetAgentProperty",
         "BTSetVar",
+        "BTSimulator",
         "BTState",
         "BTStopAnimation",
         "BTSubtree",
@@ -110,6 +114,8 @@ def get_doc_classes():
         "BTWait",
         "BTWaitTicks",
         "LimboHSM",
+        "LimboHSMBatch",
+        "LimboHSMDefinition",
         "LimboState",
         "LimboUtility",
     ]
@@ -62,6 +62,7 @@ Ref<BehaviorTreeData> BehaviorTreeData::deserialize(const Array &p_array) {
 	data->bt_player_path = p_array[0];
 	data->bt_resource_path = p_array[1];
 
+	data->tasks.reserve((p_array.size() - 2) / 8);
 	int idx = 2;
 	while (p_array.size() > idx + 1) {
 		ERR_FAIL_COND_V(p_array.size() < idx + 7, nullptr);
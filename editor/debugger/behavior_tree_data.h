@@ -14,6 +14,14 @@
 
 #include "../../bt/tasks/bt_task.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
 class BehaviorTreeData : public RefCounted {
 	GDCLASS(BehaviorTreeData, RefCounted);
 
@@ -45,7 +53,8 @@ public:
 		TaskData() {}
 	};
 
-	List<TaskData> tasks;
+	// Tasks in depth-first order.
+	LocalVector<TaskData> tasks;
 	NodePath bt_player_path;
 	String bt_resource_path;
 
@@ -16,6 +16,7 @@
 #include "../../bt/tasks/bt_task.h"
 #include "../../util/limbo_compat.h"
 #include "../../util/limbo_utility.h"
+#include "../lazy_tree_items.h"
 #include "behavior_tree_data.h"
 
 #ifdef LIMBOAI_MODULE
@@ -77,6 +78,19 @@ void BehaviorTreeView::_item_collapsed(Object *p_obj) {
 	} else if (collapsed_ids.has(id) && !collapsed) {
 		collapsed_ids.erase(id);
 	}
+
+	if (!collapsed) {
+		const int *idx_ptr = item_indices.getptr(item);
+		ERR_FAIL_COND(idx_ptr == nullptr || model_data.is_null());
+		int idx = *idx_ptr;
+		if (LazyTreeItems::has_placeholder(item)) {
+			LazyTreeItems::remove_placeholder(item);
+			_materialize_children(idx);
+		} else {
+			// * Statuses inside collapsed branches are not kept up to date.
+			_update_visible_statuses(idx + 1, subtree_ends[idx]);
+		}
+	}
 }
 
 void BehaviorTreeView::_item_selected() {
@@ -104,127 +118,163 @@ void BehaviorTreeView::update_tree(const Ref<BehaviorTreeData> &p_data) {
 	_notification(NOTIFICATION_PROCESS);
 }
 
-void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
-	// Remember selected.
-	uint64_t selected_id = 0;
-	if (tree->get_selected()) {
-		selected_id = item_get_task_id(tree->get_selected());
-	}
+TreeItem *BehaviorTreeView::_create_item(int p_idx, TreeItem *p_parent) {
+	const BehaviorTreeData::TaskData &task_data = model_data->tasks[p_idx];
 
-	if (last_root_id != 0 && p_data->tasks.size() > 0 && last_root_id == (uint64_t)p_data->tasks[0].id) {
-		// * Update tree.
-		// ! Update routine is built on assumption that the behavior tree does NOT mutate. With little work it could detect mutations.
+	TreeItem *item = tree->create_item(p_parent);
+	// Do this first because it resets properties of the cell...
+	item->set_cell_mode(0, TreeItem::CELL_MODE_CUSTOM);
+	item->set_cell_mode(1, TreeItem::CELL_MODE_ICON);
 
-		TreeItem *item = tree->get_root();
-		int idx = 0;
-		while (item) {
-			ERR_FAIL_COND(idx >= p_data->tasks.size());
-
-			const BTTask::Status current_status = (BTTask::Status)p_data->tasks[idx].status;
-			const BTTask::Status last_status = item_get_task_status(item);
-			const bool status_changed = last_status != p_data->tasks[idx].status;
-
-			if (status_changed) {
-				item->set_metadata(1, current_status);
-				if (current_status == BTTask::SUCCESS) {
-					item->set_custom_draw(0, this, LW_NAME(_draw_success_status));
-					item->set_icon(1, theme_cache.icon_success);
-				} else if (current_status == BTTask::FAILURE) {
-					item->set_custom_draw(0, this, LW_NAME(_draw_failure_status));
-					item->set_icon(1, theme_cache.icon_failure);
-				} else if (current_status == BTTask::RUNNING) {
-					item->set_custom_draw(0, this, LW_NAME(_draw_running_status));
-					item->set_icon(1, theme_cache.icon_running);
-				} else {
-					item->set_custom_draw(0, this, LW_NAME(_draw_fresh));
-					item->set_icon(1, nullptr);
-				}
-			}
+	item->set_metadata(0, task_data.id);
+	item->set_metadata(1, task_data.status);
+	item->set_metadata(2, task_data.type_name + String("|") + task_data.script_path);
 
-			if (status_changed || current_status == BTTask::RUNNING) {
-				_item_set_elapsed_time(item, p_data->tasks[idx].elapsed_time);
-			}
+	item->set_text(0, task_data.name);
+	if (task_data.is_custom_name) {
+		item->set_custom_font(0, theme_cache.font_custom_name);
+	}
 
-			if (item->get_first_child()) {
-				item = item->get_first_child();
-			} else if (item->get_next()) {
-				item = item->get_next();
-			} else {
-				while (item) {
-					item = item->get_parent();
-					if (item && item->get_next()) {
-						item = item->get_next();
-						break;
-					}
-				}
-			}
+	item->set_text_alignment(2, HORIZONTAL_ALIGNMENT_RIGHT);
+	_item_set_elapsed_time(item, task_data.elapsed_time);
+
+	String cors = (task_data.script_path.is_empty()) ? task_data.type_name : task_data.script_path;
+	item->set_icon(0, LimboUtility::get_singleton()->get_task_icon(cors));
+	item->set_icon_max_width(0, 16 * _get_editor_scale()); // Force user icon size.
+
+	if (task_data.status == BTTask::SUCCESS) {
+		item->set_custom_draw(0, this, LW_NAME(_draw_success_status));
+		item->set_icon(1, theme_cache.icon_success);
+	} else if (task_data.status == BTTask::FAILURE) {
+		item->set_custom_draw(0, this, LW_NAME(_draw_failure_status));
+		item->set_icon(1, theme_cache.icon_failure);
+	} else if (task_data.status == BTTask::RUNNING) {
+		item->set_custom_draw(0, this, LW_NAME(_draw_running_status));
+		item->set_icon(1, theme_cache.icon_running);
+	}
 
-			idx += 1;
+	if (collapsed_ids.has(task_data.id)) {
+		item->set_collapsed(true);
+	}
+	item_indices.insert(item, p_idx);
+	return item;
+}
+
+// Creates items for the children of p_idx, descending into expanded branches only.
+void BehaviorTreeView::_materialize_children(int p_idx) {
+	TreeItem *item = items[p_idx];
+	if (item->is_collapsed()) {
+		if (model_data->tasks[p_idx].num_children > 0) {
+			LazyTreeItems::add_placeholder(tree, item);
 		}
-		ERR_FAIL_COND(idx != p_data->tasks.size());
-	} else {
-		// * Create new tree.
+		return;
+	}
+	int child_idx = p_idx + 1;
+	while (child_idx < subtree_ends[p_idx]) {
+		items[child_idx] = _create_item(child_idx, item);
+		_materialize_children(child_idx);
+		child_idx = subtree_ends[child_idx];
+	}
+}
 
-		last_root_id = p_data->tasks.size() > 0 ? p_data->tasks[0].id : 0;
+void BehaviorTreeView::_build_model(const Ref<BehaviorTreeData> &p_data) {
+	const int num_tasks = p_data->tasks.size();
+	model_data = p_data;
+	items.resize(num_tasks);
+	item_indices.clear();
+	subtree_ends.resize(num_tasks);
+
+	// * Tasks are in depth-first order: a branch ends when the last of its children ends.
+	LocalVector<Pair<int, int>> open_branches; // task index | children left to visit
+	for (int i = 0; i < num_tasks; i++) {
+		items[i] = nullptr;
+		if (!open_branches.is_empty()) {
+			open_branches[open_branches.size() - 1].second -= 1;
+		}
+		open_branches.push_back(Pair<int, int>(i, p_data->tasks[i].num_children));
+		while (!open_branches.is_empty() && open_branches[open_branches.size() - 1].second <= 0) {
+			subtree_ends[open_branches[open_branches.size() - 1].first] = i + 1;
+			open_branches.resize(open_branches.size() - 1);
+		}
+	}
+	for (const Pair<int, int> &branch : open_branches) {
+		// * Only reachable with malformed data.
+		subtree_ends[branch.first] = num_tasks;
+	}
 
-		tree->clear();
-		TreeItem *parent = nullptr;
-		List<Pair<TreeItem *, int>> parents;
-		for (const BehaviorTreeData::TaskData &task_data : p_data->tasks) {
-			// Figure out parent.
-			parent = nullptr;
-			if (parents.size()) {
-				Pair<TreeItem *, int> &p = parents[0];
-				parent = p.first;
-				if (!(--p.second)) {
-					// No children left, remove it.
-					parents.pop_front();
-				}
-			}
+	if (num_tasks > 0) {
+		items[0] = _create_item(0, nullptr);
+		_materialize_children(0);
+	}
+}
 
-			TreeItem *item = tree->create_item(parent);
-			// Do this first because it resets properties of the cell...
-			item->set_cell_mode(0, TreeItem::CELL_MODE_CUSTOM);
-			item->set_cell_mode(1, TreeItem::CELL_MODE_ICON);
+void BehaviorTreeView::_update_item_status(TreeItem *p_item, const BehaviorTreeData::TaskData &p_task_data) {
+	const BTTask::Status current_status = (BTTask::Status)p_task_data.status;
+	const BTTask::Status last_status = item_get_task_status(p_item);
+	const bool status_changed = last_status != current_status;
+
+	if (status_changed) {
+		p_item->set_metadata(1, current_status);
+		if (current_status == BTTask::SUCCESS) {
+			p_item->set_custom_draw(0, this, LW_NAME(_draw_success_status));
+			p_item->set_icon(1, theme_cache.icon_success);
+		} else if (current_status == BTTask::FAILURE) {
+			p_item->set_custom_draw(0, this, LW_NAME(_draw_failure_status));
+			p_item->set_icon(1, theme_cache.icon_failure);
+		} else if (current_status == BTTask::RUNNING) {
+			p_item->set_custom_draw(0, this, LW_NAME(_draw_running_status));
+			p_item->set_icon(1, theme_cache.icon_running);
+		} else {
+			p_item->set_custom_draw(0, this, LW_NAME(_draw_fresh));
+			p_item->set_icon(1, nullptr);
+		}
+	}
 
-			item->set_metadata(0, task_data.id);
-			item->set_metadata(1, task_data.status);
-			item->set_metadata(2, task_data.type_name + String("|") + task_data.script_path);
+	if (status_changed || current_status == BTTask::RUNNING) {
+		_item_set_elapsed_time(p_item, p_task_data.elapsed_time);
+	}
+}
 
-			item->set_text(0, task_data.name);
-			if (task_data.is_custom_name) {
-				item->set_custom_font(0, theme_cache.font_custom_name);
-			}
+// Updates items in [p_from, p_to), skipping the contents of collapsed branches.
+void BehaviorTreeView::_update_visible_statuses(int p_from, int p_to) {
+	int idx = p_from;
+	while (idx < p_to) {
+		TreeItem *item = items[idx];
+		if (item == nullptr) {
+			idx = subtree_ends[idx];
+			continue;
+		}
+		_update_item_status(item, model_data->tasks[idx]);
+		idx = item->is_collapsed() ? subtree_ends[idx] : idx + 1;
+	}
+}
 
-			item->set_text_alignment(2, HORIZONTAL_ALIGNMENT_RIGHT);
-			_item_set_elapsed_time(item, task_data.elapsed_time);
-
-			String cors = (task_data.script_path.is_empty()) ? task_data.type_name : task_data.script_path;
-			item->set_icon(0, LimboUtility::get_singleton()->get_task_icon(cors));
-			item->set_icon_max_width(0, 16 * _get_editor_scale()); // Force user icon size.
-
-			if (task_data.status == BTTask::SUCCESS) {
-				item->set_custom_draw(0, this, LW_NAME(_draw_success_status));
-				item->set_icon(1, theme_cache.icon_success);
-			} else if (task_data.status == BTTask::FAILURE) {
-				item->set_custom_draw(0, this, LW_NAME(_draw_failure_status));
-				item->set_icon(1, theme_cache.icon_failure);
-			} else if (task_data.status == BTTask::RUNNING) {
-				item->set_custom_draw(0, this, LW_NAME(_draw_running_status));
-				item->set_icon(1, theme_cache.icon_running);
-			}
+void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
+	if (last_root_id != 0 && p_data->tasks.size() > 0 && last_root_id == (uint64_t)p_data->tasks[0].id && p_data->tasks.size() == items.size()) {
+		// * Update tree.
+		// ! Update routine is built on assumption that the behavior tree does NOT mutate. With little work it could detect mutations.
+		model_data = p_data;
+		_update_visible_statuses(0, items.size());
+	} else {
+		// * Create new tree.
 
-			if (task_data.id == selected_id) {
-				tree->set_selected(item, 0);
-			}
+		// Remember selected.
+		uint64_t selected_id = 0;
+		if (tree->get_selected()) {
+			selected_id = item_get_task_id(tree->get_selected());
+		}
 
-			if (collapsed_ids.has(task_data.id)) {
-				item->set_collapsed(true);
-			}
+		last_root_id = p_data->tasks.size() > 0 ? p_data->tasks[0].id : 0;
 
-			// Add in front of parents stack if children are expected.
-			if (task_data.num_children) {
-				parents.push_front(Pair<TreeItem *, int>(item, task_data.num_children));
+		tree->clear();
+		_build_model(p_data);
+
+		if (selected_id != 0) {
+			for (uint32_t i = 0; i < items.size(); i++) {
+				if (items[i] && p_data->tasks[i].id == selected_id) {
+					tree->set_selected(items[i], 0);
+					break;
+				}
 			}
 		}
 	}
@@ -234,6 +284,10 @@ void BehaviorTreeView::clear() {
 	tree->clear();
 	collapsed_ids.clear();
 	last_root_id = 0;
+	model_data.unref();
+	items.clear();
+	item_indices.clear();
+	subtree_ends.clear();
 }
 
 void BehaviorTreeView::_do_update_theme_item_cache() {
@@ -28,6 +28,7 @@
 #include <godot_cpp/classes/font.hpp>
 #include <godot_cpp/classes/style_box_flat.hpp>
 #include <godot_cpp/classes/tree.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 class BehaviorTreeView : public Control {
@@ -51,6 +52,13 @@ private:
 	Vector<uint64_t> collapsed_ids;
 	uint64_t last_root_id = 0;
 
+	// Flat model of the displayed tree, indexed like BehaviorTreeData::tasks.
+	// Items exist only for tasks in expanded branches; the rest are nullptr until their branch is expanded.
+	Ref<BehaviorTreeData> model_data;
+	LocalVector<TreeItem *> items;
+	HashMap<TreeItem *, int> item_indices; // Reverse lookup for items.
+	LocalVector<int> subtree_ends; // Index past the last descendant of each task.
+
 	int last_update_msec = 0;
 	int update_interval_msec = 0;
 	Ref<BehaviorTreeData> update_data;
@@ -64,6 +72,11 @@ private:
 	void _item_selected();
 	double _get_editor_scale() const;
 
+	TreeItem *_create_item(int p_idx, TreeItem *p_parent);
+	void _materialize_children(int p_idx);
+	void _build_model(const Ref<BehaviorTreeData> &p_data);
+	void _update_item_status(TreeItem *p_item, const BehaviorTreeData::TaskData &p_task_data);
+	void _update_visible_statuses(int p_from, int p_to);
 	void _update_tree(const Ref<BehaviorTreeData> &p_data);
 
 protected:
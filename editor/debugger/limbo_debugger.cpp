@@ -19,6 +19,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/error/error_macros.h"
 #include "core/io/resource.h"
+#include "core/os/time.h"
 #include "core/string/node_path.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
@@ -27,6 +28,7 @@
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/engine_debugger.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/classes/window.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
@@ -68,8 +70,6 @@ void LimboDebugger::_bind_methods() {
 #ifdef LIMBOAI_GDEXTENSION
 	ClassDB::bind_method(D_METHOD("parse_message_gdext"), &LimboDebugger::parse_message_gdext);
 #endif
-	ClassDB::bind_method(D_METHOD("_on_bt_updated", "status", "path"), &LimboDebugger::_on_bt_updated);
-	ClassDB::bind_method(D_METHOD("_on_state_updated", "delta", "path"), &LimboDebugger::_on_state_updated);
 #endif // ! DEBUG_ENABLED
 }
 
@@ -138,6 +138,8 @@ void LimboDebugger::_track_tree(NodePath p_path) {
 	ERR_FAIL_COND(node == nullptr);
 
 	tracked_player = p_path;
+	tracked_id = uint64_t(node->get_instance_id());
+	alloc_stats_sent_msec = 0;
 
 	Ref<Resource> bt = node->get(LW_NAME(behavior_tree));
 
@@ -146,12 +148,6 @@ void LimboDebugger::_track_tree(NodePath p_path) {
 	} else {
 		bt_resource_path = "";
 	}
-
-	if (node->is_class("BTPlayer")) {
-		node->connect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_bt_updated).bind(p_path));
-	} else if (node->is_class("BTState")) {
-		node->connect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_state_updated).bind(p_path));
-	}
 }
 
 void LimboDebugger::_untrack_tree() {
@@ -159,17 +155,8 @@ void LimboDebugger::_untrack_tree() {
 		return;
 	}
 
-	NodePath was_tracking = tracked_player;
 	tracked_player = NodePath();
-
-	Node *node = SCENE_TREE()->get_root()->get_node_or_null(was_tracking);
-	ERR_FAIL_COND(node == nullptr);
-
-	if (node->is_class("BTPlayer")) {
-		node->disconnect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_bt_updated));
-	} else if (node->is_class("BTState")) {
-		node->disconnect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_state_updated));
-	}
+	tracked_id = 0;
 }
 
 void LimboDebugger::_send_active_bt_players() {
@@ -180,20 +167,28 @@ void LimboDebugger::_send_active_bt_players() {
 	EngineDebugger::get_singleton()->send_message("limboai:active_bt_players", arr);
 }
 
-void LimboDebugger::_on_bt_updated(int _status, NodePath p_path) {
-	if (p_path != tracked_player) {
-		return;
-	}
+void LimboDebugger::_send_tree_update() {
 	Array arr = BehaviorTreeData::serialize(active_trees.get(tracked_player), tracked_player, bt_resource_path);
 	EngineDebugger::get_singleton()->send_message("limboai:bt_update", arr);
 }
 
-void LimboDebugger::_on_state_updated(float _delta, NodePath p_path) {
-	if (p_path != tracked_player) {
+void LimboDebugger::send_alloc_stats(const NodePath &p_player_path, const LimboAllocTracker &p_tracker) {
+	if (!session_active || p_player_path != tracked_player) {
 		return;
 	}
-	Array arr = BehaviorTreeData::serialize(active_trees.get(tracked_player), tracked_player, bt_resource_path);
-	EngineDebugger::get_singleton()->send_message("limboai:bt_update", arr);
+	// * Mean and max are aggregated by the tracker, so skipping updates in between loses only the last tick samples.
+	uint64_t now = Time::get_singleton()->get_ticks_msec();
+	if (alloc_stats_sent_msec != 0 && now - alloc_stats_sent_msec < ALLOC_STATS_INTERVAL_MSEC) {
+		return;
+	}
+	alloc_stats_sent_msec = now;
+	Array arr;
+	arr.push_back(p_player_path);
+	arr.push_back(p_tracker.get_instantiate_bytes());
+	arr.push_back(p_tracker.get_last_tick_bytes());
+	arr.push_back(p_tracker.get_mean_tick_bytes());
+	arr.push_back(p_tracker.get_max_tick_bytes());
+	EngineDebugger::get_singleton()->send_message("limboai:bt_alloc_stats", arr);
 }
 
 #endif // ! DEBUG_ENABLED
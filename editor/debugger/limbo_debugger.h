@@ -13,6 +13,7 @@
 #define LIMBO_DEBUGGER_H
 
 #include "../../bt/tasks/bt_task.h"
+#include "../../util/limbo_alloc_tracker.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/class_db.h"
@@ -48,15 +49,18 @@ protected:
 private:
 	HashMap<NodePath, Ref<BTTask>> active_trees;
 	NodePath tracked_player;
+	uint64_t tracked_id = 0;
 	String bt_resource_path;
 	bool session_active = false;
 
+	// Allocation stats are sent at most once per interval rather than on every tick.
+	static constexpr uint64_t ALLOC_STATS_INTERVAL_MSEC = 250;
+	uint64_t alloc_stats_sent_msec = 0;
+
 	void _track_tree(NodePath p_path);
 	void _untrack_tree();
 	void _send_active_bt_players();
-
-	void _on_bt_updated(int status, NodePath p_path);
-	void _on_state_updated(float _delta, NodePath p_path);
+	void _send_tree_update();
 
 public:
 	static Error parse_message(void *p_user, const String &p_msg, const Array &p_args, bool &r_captured);
@@ -66,6 +70,14 @@ public:
 
 	void register_bt_instance(Ref<BTTask> p_instance, NodePath p_player_path);
 	void unregister_bt_instance(Ref<BTTask> p_instance, NodePath p_player_path);
+	void send_alloc_stats(const NodePath &p_player_path, const LimboAllocTracker &p_tracker);
+
+	// Called by BTPlayer and BTState after each update; cheaper than a signal connection.
+	_FORCE_INLINE_ void notify_tree_updated(const Object *p_node) {
+		if (unlikely(tracked_id != 0 && uint64_t(p_node->get_instance_id()) == tracked_id)) {
+			_send_tree_update();
+		}
+	}
 
 #endif // ! DEBUG_ENABLED
 };
@@ -65,6 +65,7 @@ void LimboDebuggerTab::_reset_controls() {
 	info_message->show();
 	resource_header->set_disabled(true);
 	resource_header->set_text(TTR("Inactive"));
+	alloc_stats->hide();
 }
 
 void LimboDebuggerTab::start_session() {
@@ -103,6 +104,16 @@ void LimboDebuggerTab::update_behavior_tree(const Ref<BehaviorTreeData> &p_data)
 	info_message->hide();
 }
 
+void LimboDebuggerTab::update_alloc_stats(const Array &p_data) {
+	ERR_FAIL_COND(p_data.size() < 5);
+	if (NodePath(p_data[0]) != NodePath(get_selected_bt_player())) {
+		return;
+	}
+	alloc_stats->set_text(vformat(TTR("Alloc: %d B/tick (mean: %.1f, max: %d), instantiate: %d B"),
+			p_data[2], p_data[3], p_data[4], p_data[1]));
+	alloc_stats->show();
+}
+
 void LimboDebuggerTab::_show_alert(const String &p_message) {
 	alert_message->set_text(p_message);
 	alert_box->set_visible(!p_message.is_empty());
@@ -152,6 +163,7 @@ void LimboDebuggerTab::_bt_selected(int p_idx) {
 	info_message->show();
 	resource_header->set_text(TTR("Waiting for data"));
 	resource_header->set_disabled(true);
+	alloc_stats->hide();
 	NodePath path = bt_player_list->get_item_text(p_idx);
 	Array msg_data;
 	msg_data.push_back(path);
@@ -243,6 +255,12 @@ LimboDebuggerTab::LimboDebuggerTab() {
 	resource_header->set_tooltip_text(TTR("Debugged BehaviorTree resource.\nClick to open."));
 	resource_header->set_disabled(true);
 
+	alloc_stats = memnew(Label);
+	toolbar->add_child(alloc_stats);
+	alloc_stats->set_tooltip_text(TTR("Memory retained by the tracked BTPlayer (net bytes). Memory freed within the same update is not counted.\nEnable \"monitor_allocations\" on BTPlayer to collect these statistics."));
+	alloc_stats->set_mouse_filter(MOUSE_FILTER_PASS);
+	alloc_stats->hide();
+
 	Label *interval_label = memnew(Label);
 	toolbar->add_child(interval_label);
 	interval_label->set_text(TTR("Update Interval:"));
@@ -358,6 +376,8 @@ bool LimboDebuggerPlugin::_capture(const String &p_message, const Array &p_data,
 		if (data->bt_player_path == NodePath(tab->get_selected_bt_player())) {
 			tab->update_behavior_tree(data);
 		}
+	} else if (p_message == "limboai:bt_alloc_stats") {
+		tab->update_alloc_stats(p_data);
 	} else {
 		captured = false;
 	}
@@ -65,6 +65,7 @@ private:
 	Label *alert_message = nullptr;
 	LineEdit *filter_players = nullptr;
 	Button *resource_header = nullptr;
+	Label *alloc_stats = nullptr;
 	Button *make_floating = nullptr;
 	EditorSpinSlider *update_interval = nullptr;
 	CompatWindowWrapper *window_wrapper = nullptr;
@@ -88,6 +89,7 @@ public:
 	BehaviorTreeView *get_behavior_tree_view() const { return bt_view; }
 	String get_selected_bt_player();
 	void update_behavior_tree(const Ref<BehaviorTreeData> &p_data);
+	void update_alloc_stats(const Array &p_data);
 
 	void setup(Ref<EditorDebuggerSession> p_session, CompatWindowWrapper *p_wrapper);
 	LimboDebuggerTab();
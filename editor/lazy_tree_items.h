@@ -0,0 +1,52 @@
+/**
+ * lazy_tree_items.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifdef TOOLS_ENABLED
+
+#ifndef LAZY_TREE_ITEMS_H
+#define LAZY_TREE_ITEMS_H
+
+#ifdef LIMBOAI_MODULE
+#include "scene/gui/tree.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/tree.hpp>
+#include <godot_cpp/classes/tree_item.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+// Helpers for tree views that create the items of a collapsed branch only once it is expanded.
+// Until then, the branch holds a single placeholder child, so that its fold arrow is still shown.
+// Placeholders are told apart from real items by their empty metadata in the first column.
+namespace LazyTreeItems {
+
+inline TreeItem *add_placeholder(Tree *p_tree, TreeItem *p_parent) {
+	TreeItem *placeholder = p_tree->create_item(p_parent);
+	placeholder->set_selectable(0, false);
+	return placeholder;
+}
+
+inline bool has_placeholder(const TreeItem *p_item) {
+	TreeItem *child = p_item->get_first_child();
+	return child != nullptr && child->get_metadata(0).get_type() == Variant::NIL;
+}
+
+inline void remove_placeholder(TreeItem *p_item) {
+	if (has_placeholder(p_item)) {
+		memdelete(p_item->get_first_child());
+	}
+}
+
+} // namespace LazyTreeItems
+
+#endif // ! LAZY_TREE_ITEMS_H
+
+#endif // ! TOOLS_ENABLED
@@ -14,11 +14,13 @@
 #include "limbo_ai_editor_plugin.h"
 
 #include "../bt/behavior_tree.h"
+#include "../bt/bt_analyzer.h"
 #include "../bt/tasks/bt_comment.h"
 #include "../bt/tasks/composites/bt_probability_selector.h"
 #include "../bt/tasks/composites/bt_selector.h"
 #include "../bt/tasks/decorators/bt_subtree.h"
 #include "../util/limbo_compat.h"
+#include "../util/limbo_task_db.h"
 #include "../util/limbo_utility.h"
 #include "../util/limboai_version.h"
 #include "action_banner.h"
@@ -30,6 +32,7 @@
 #include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
 #include "core/input/input.h"
+#include "core/io/json.h"
 #include "editor/debugger/editor_debugger_node.h"
 #include "editor/debugger/script_editor_debugger.h"
 #include "editor/editor_file_system.h"
@@ -62,6 +65,7 @@
 #include <godot_cpp/classes/input.hpp>
 #include <godot_cpp/classes/input_event.hpp>
 #include <godot_cpp/classes/input_event_mouse_button.hpp>
+#include <godot_cpp/classes/json.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
@@ -204,17 +208,74 @@ void LimboAIEditor::_save_bt(String p_path) {
 
 void LimboAIEditor::_load_bt(String p_path) {
 	ERR_FAIL_COND_MSG(p_path.is_empty(), "Empty p_path");
-	Ref<BehaviorTree> bt = RESOURCE_LOAD(p_path, "BehaviorTree");
-	ERR_FAIL_COND(!bt.is_valid());
-	if (bt->get_blackboard_plan().is_null()) {
-		bt->set_blackboard_plan(memnew(BlackboardPlan));
+	if (RESOURCE_IS_CACHED(p_path) || RESOURCE_PATH_IS_BUILT_IN(p_path)) {
+		Ref<BehaviorTree> bt = RESOURCE_LOAD(p_path, "BehaviorTree");
+		ERR_FAIL_COND(!bt.is_valid());
+		_edit_loaded_bt(bt);
+		return;
+	}
+
+	// * Large trees take a while to parse: load in the background and show progress.
+	if (!loading_paths.has(p_path)) {
+		Error err = RESOURCE_LOAD_THREADED_REQUEST(p_path, "BehaviorTree");
+		ERR_FAIL_COND_MSG(err != OK, "LimboAIEditor: Failed to request loading: " + p_path);
+		loading_paths.push_back(p_path);
+	}
+	pending_edit_path = p_path;
+	load_progress->set_value(0.0);
+	load_progress->set_tooltip_text(vformat(TTR("Loading %s..."), p_path.get_file()));
+	load_progress->show();
+	set_process(true);
+}
+
+void LimboAIEditor::_edit_loaded_bt(const Ref<BehaviorTree> &p_behavior_tree) {
+	if (p_behavior_tree->get_blackboard_plan().is_null()) {
+		p_behavior_tree->set_blackboard_plan(memnew(BlackboardPlan));
 	}
 	// if (history.find(bt) != -1) {
 	// 	history.erase(bt);
 	// 	history.push_back(bt);
 	// }
 
-	EDIT_RESOURCE(bt);
+	EDIT_RESOURCE(p_behavior_tree);
+}
+
+void LimboAIEditor::_poll_pending_loads() {
+	for (int i = loading_paths.size() - 1; i >= 0; i--) {
+		const String path = loading_paths[i];
+		float progress = 0.0;
+#ifdef LIMBOAI_MODULE
+		ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(path, &progress);
+#elif LIMBOAI_GDEXTENSION
+		Array progress_arr;
+		ResourceLoader::ThreadLoadStatus status = ResourceLoader::get_singleton()->load_threaded_get_status(path, progress_arr);
+		if (progress_arr.size() > 0) {
+			progress = progress_arr[0];
+		}
+#endif
+		if (status == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+			if (path == pending_edit_path) {
+				load_progress->set_value(progress);
+			}
+			continue;
+		}
+
+		loading_paths.remove_at(i);
+		Ref<BehaviorTree> bt;
+		if (status != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE) {
+			bt = RESOURCE_LOAD_THREADED_GET(path);
+		}
+		if (path == pending_edit_path) {
+			pending_edit_path = String();
+			load_progress->hide();
+			ERR_CONTINUE_MSG(bt.is_null(), "LimboAIEditor: Failed to load behavior tree: " + path);
+			_edit_loaded_bt(bt);
+		}
+	}
+
+	if (loading_paths.is_empty()) {
+		set_process(false);
+	}
 }
 
 void LimboAIEditor::_disable_editing() {
@@ -308,6 +369,22 @@ void LimboAIEditor::_edit_project_settings() {
 #endif
 }
 
+void LimboAIEditor::_analyze_project_trees() {
+	Ref<BTAnalyzer> analyzer = memnew(BTAnalyzer);
+	Dictionary report = analyzer->analyze_project();
+
+	String report_path = GET_PROJECT_SETTINGS_DIR().path_join("limbo_ai_tree_analysis.json");
+	Ref<FileAccess> f = FileAccess::open(report_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "LimboAIEditor: Failed to write tree analysis report: " + report_path);
+	f->store_string(JSON::stringify(report, "\t"));
+	f->close();
+
+	Dictionary summary = report["summary"];
+	_popup_info_dialog(vformat(TTR("Analyzed %d behavior trees (%d tasks).\nUnused variables: %d\nUnreachable tasks: %d\nErrors: %d\n\nFull report: %s"),
+			int(summary["trees"]), int(summary["task_count"]), int(summary["unused_vars"]),
+			int(summary["unreachable"]), int(summary["errors"]), report_path));
+}
+
 void LimboAIEditor::_remove_task_from_favorite(const String &p_task) {
 	PackedStringArray favorite_tasks = GLOBAL_GET("limbo_ai/behavior_tree/favorite_tasks");
 	int idx = favorite_tasks.find(p_task);
@@ -701,6 +778,9 @@ void LimboAIEditor::_misc_option_selected(int p_id) {
 		case MISC_PROJECT_SETTINGS: {
 			_edit_project_settings();
 		} break;
+		case MISC_ANALYZE_TREES: {
+			_analyze_project_trees();
+		} break;
 		case MISC_CREATE_SCRIPT_TEMPLATE: {
 			String template_path = _get_script_template_path();
 			String template_dir = template_path.get_base_dir();
@@ -770,7 +850,7 @@ void LimboAIEditor::_on_visibility_changed() {
 			EDIT_RESOURCE(task_tree->get_bt());
 		}
 
-		task_palette->refresh();
+		task_palette->refresh_if_outdated();
 	}
 	_update_favorite_tasks();
 }
@@ -847,7 +927,21 @@ void LimboAIEditor::_on_task_dragged(Ref<BTTask> p_task, Ref<BTTask> p_to_task,
 	_mark_as_dirty(true);
 }
 
+void LimboAIEditor::_on_filesystem_changed() {
+	LimboTaskDB::mark_user_tasks_dirty();
+	// * Global class icons may have changed.
+	LimboUtility::get_singleton()->clear_task_icon_cache();
+	if (task_palette->is_visible_in_tree()) {
+		task_palette->refresh_if_outdated();
+	}
+}
+
 void LimboAIEditor::_on_resources_reload(const PackedStringArray &p_resources) {
+	// * Reloaded scripts may change task icons and generated names.
+	LimboUtility::get_singleton()->clear_task_icon_cache();
+	LimboUtility::get_singleton()->clear_task_name_cache();
+	task_tree->refresh_all_items();
+
 	for (const String &res_path : p_resources) {
 		if (!RESOURCE_IS_CACHED(res_path)) {
 			continue;
@@ -1214,6 +1308,7 @@ void LimboAIEditor::_update_misc_menu() {
 	misc_menu->add_icon_shortcut(theme_cache.open_debugger_icon, LW_GET_SHORTCUT("limbo_ai/open_debugger"), MISC_OPEN_DEBUGGER);
 #endif // LIMBOAI_MODULE
 	misc_menu->add_item(TTR("Project Settings..."), MISC_PROJECT_SETTINGS);
+	misc_menu->add_item(TTR("Analyze Behavior Trees"), MISC_ANALYZE_TREES);
 
 	misc_menu->add_separator();
 	misc_menu->add_item(
@@ -1339,9 +1434,14 @@ void LimboAIEditor::_notification(int p_what) {
 			version_btn->connect(LW_NAME(pressed), callable_mp(this, &LimboAIEditor::_copy_version_info));
 
 			EDITOR_FILE_SYSTEM()->connect("resources_reload", callable_mp(this, &LimboAIEditor::_on_resources_reload));
+			EDITOR_FILE_SYSTEM()->connect("filesystem_changed", callable_mp(this, &LimboAIEditor::_on_filesystem_changed));
 
 		} break;
+		case NOTIFICATION_PROCESS: {
+			_poll_pending_loads();
+		} break;
 		case NOTIFICATION_THEME_CHANGED: {
+			LimboUtility::get_singleton()->clear_task_icon_cache();
 			_do_update_theme_item_cache();
 
 			ADD_STYLEBOX_OVERRIDE(tab_bar_panel, "panel", get_theme_stylebox("tabbar_background", "TabContainer"));
@@ -1511,6 +1611,15 @@ LimboAIEditor::LimboAIEditor() {
 	tab_bar->set_focus_mode(FocusMode::FOCUS_NONE);
 	tab_bar_container->add_child(tab_bar);
 
+	load_progress = memnew(ProgressBar);
+	load_progress->set_max(1.0);
+	load_progress->set_step(0.0);
+	load_progress->set_show_percentage(false);
+	load_progress->set_custom_minimum_size(Size2(100, 0) * EDSCALE);
+	load_progress->set_v_size_flags(SIZE_SHRINK_CENTER);
+	load_progress->hide();
+	tab_bar_container->add_child(load_progress);
+
 	tab_menu = memnew(PopupMenu);
 	add_child(tab_menu);
 
@@ -39,6 +39,7 @@
 #include "scene/gui/panel_container.h"
 #include "scene/gui/popup.h"
 #include "scene/gui/popup_menu.h"
+#include "scene/gui/progress_bar.h"
 #include "scene/gui/split_container.h"
 #include "scene/gui/tree.h"
 #include "scene/resources/texture.h"
@@ -60,6 +61,7 @@
 #include <godot_cpp/classes/menu_button.hpp>
 #include <godot_cpp/classes/panel.hpp>
 #include <godot_cpp/classes/popup_menu.hpp>
+#include <godot_cpp/classes/progress_bar.hpp>
 #include <godot_cpp/classes/tab_bar.hpp>
 #include <godot_cpp/classes/texture2d.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
@@ -99,6 +101,7 @@ private:
 		MISC_DOC_CUSTOM_TASKS,
 		MISC_OPEN_DEBUGGER,
 		MISC_PROJECT_SETTINGS,
+		MISC_ANALYZE_TREES,
 		MISC_CREATE_SCRIPT_TEMPLATE,
 	};
 
@@ -138,11 +141,16 @@ private:
 	HashSet<Ref<BehaviorTree>> dirty;
 	Ref<BTTask> clipboard_task;
 
+	// Trees requested from the threaded loader, and the one to edit once it is loaded.
+	Vector<String> loading_paths;
+	String pending_edit_path;
+
 	VBoxContainer *vbox;
 	PanelContainer *tab_bar_panel;
 	HBoxContainer *tab_bar_container;
 	LinkButton *version_btn;
 	TabBar *tab_bar;
+	ProgressBar *load_progress;
 	PopupMenu *tab_menu;
 	OwnerPicker *owner_picker;
 	HSplitContainer *hsc;
@@ -191,6 +199,8 @@ private:
 	void _new_bt();
 	void _save_bt(String p_path);
 	void _load_bt(String p_path);
+	void _edit_loaded_bt(const Ref<BehaviorTree> &p_behavior_tree);
+	void _poll_pending_loads();
 	void _disable_editing();
 	void _mark_as_dirty(bool p_dirty);
 	void _create_user_task_dir();
@@ -226,11 +236,13 @@ private:
 	void _on_history_back();
 	void _on_history_forward();
 	void _on_task_dragged(Ref<BTTask> p_task, Ref<BTTask> p_to_task, int p_type);
+	void _on_filesystem_changed();
 	void _on_resources_reload(const PackedStringArray &p_resources);
 	void _task_type_selected(const String &p_class_or_path);
 	void _copy_version_info();
 
 	void _edit_project_settings();
+	void _analyze_project_trees();
 	void _process_shortcut_input(const Ref<InputEvent> &p_event);
 
 #ifdef LIMBOAI_MODULE
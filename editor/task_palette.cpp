@@ -57,15 +57,40 @@ using namespace godot;
 void TaskButton::_bind_methods() {
 }
 
+#ifdef LIMBOAI_MODULE
+static String _get_task_description(const String &p_task_meta) {
+	DocTools *dd = EditorHelp::get_doc_data();
+	HashMap<String, DocData::ClassDoc>::Iterator E;
+	// Try-find core class.
+	E = dd->class_list.find(p_task_meta);
+	if (!E) {
+		// Try to find by script filename.
+		E = dd->class_list.find(vformat("\"%s\"", p_task_meta.trim_prefix("res://")));
+	}
+	if (!E) {
+		// Try-find global script class.
+		String maybe_class_name = p_task_meta.get_file().get_basename().to_pascal_case();
+		E = dd->class_list.find(maybe_class_name);
+	}
+
+	if (!E) {
+		return String();
+	}
+	if (E->value.description.is_empty() || E->value.description.length() > 1400) {
+		return DTR(E->value.brief_description);
+	}
+	return DTR(E->value.description);
+}
+#endif // LIMBOAI_MODULE
+
 Control *TaskButton::_do_make_tooltip(const String &p_text) const {
 #ifdef LIMBOAI_MODULE
 	EditorHelpBit *help_bit = memnew(EditorHelpBit);
 	help_bit->get_rich_text()->set_custom_minimum_size(Size2(360 * EDSCALE, 1));
 
-	String help_text;
-	if (!p_text.is_empty()) {
-		help_text = p_text;
-	} else {
+	// * Documentation is looked up when the tooltip is shown.
+	String help_text = task_meta.is_empty() ? p_text : _get_task_description(task_meta);
+	if (help_text.is_empty()) {
 		help_text = "[i]" + TTR("No description.") + "[/i]";
 	}
 
@@ -125,15 +150,17 @@ void TaskPaletteSection::set_filter(String p_filter_text) {
 	}
 }
 
-void TaskPaletteSection::add_task_button(const String &p_name, const Ref<Texture> &icon, const String &p_tooltip, Variant p_meta) {
+TaskButton *TaskPaletteSection::add_task_button(const String &p_name, const Ref<Texture> &icon, const String &p_tooltip, Variant p_meta) {
 	TaskButton *btn = memnew(TaskButton);
 	btn->set_text(p_name);
+	btn->set_task_meta(p_meta);
 	BUTTON_SET_ICON(btn, icon);
 	btn->set_tooltip_text(p_tooltip);
 	btn->add_theme_constant_override(LW_NAME(icon_max_width), 16 * EDSCALE); // Force user icons to  be of the proper size.
 	btn->connect(LW_NAME(pressed), callable_mp(this, &TaskPaletteSection::_on_task_button_pressed).bind(p_meta));
 	btn->connect(LW_NAME(gui_input), callable_mp(this, &TaskPaletteSection::_on_task_button_gui_input).bind(p_meta));
 	tasks_container->add_child(btn);
+	return btn;
 }
 
 void TaskPaletteSection::set_collapsed(bool p_collapsed) {
@@ -405,10 +432,13 @@ void TaskPalette::refresh() {
 			sections->get_child(i)->queue_free();
 		}
 	}
+	pending_icons.clear();
 
 	LimboTaskDB::scan_user_tasks();
+	tasks_revision = LimboTaskDB::get_revision();
 	List<String> categories = LimboTaskDB::get_categories();
 	categories.sort();
+	Ref<Texture2D> script_icon = get_theme_icon(LW_NAME(Script), LW_NAME(EditorIcons));
 
 	for (String cat : categories) {
 		if (filter_settings.category_filter != FilterSettings::CATEGORY_ALL && filter_settings.excluded_categories.has(cat)) {
@@ -423,10 +453,7 @@ void TaskPalette::refresh() {
 		TaskPaletteSection *sec = memnew(TaskPaletteSection());
 		sec->set_category_name(cat);
 		for (String task_meta : tasks) {
-			Ref<Texture2D> icon = LimboUtility::get_singleton()->get_task_icon(task_meta);
-
 			String tname;
-			String descr;
 
 			if (task_meta.begins_with("res:")) {
 				if (filter_settings.type_filter == FilterSettings::TYPE_CORE) {
@@ -440,34 +467,16 @@ void TaskPalette::refresh() {
 				tname = task_meta.trim_prefix("BT");
 			}
 
+			// * Tooltip text is set to enable custom tooltips; the description is looked up on demand.
+			String tooltip;
 #ifdef LIMBOAI_MODULE
-			// Get documentation.
-			DocTools *dd = EditorHelp::get_doc_data();
-			HashMap<String, DocData::ClassDoc>::Iterator E;
-			// Try-find core class.
-			E = dd->class_list.find(task_meta);
-			if (!E) {
-				// Try to find by script filename.
-				E = dd->class_list.find(vformat("\"%s\"", task_meta.trim_prefix("res://")));
-			}
-			if (!E) {
-				// Try-find global script class.
-				String maybe_class_name = task_meta.get_file().get_basename().to_pascal_case();
-				E = dd->class_list.find(maybe_class_name);
-			}
-
-			if (E) {
-				if (E->value.description.is_empty() || E->value.description.length() > 1400) {
-					descr = DTR(E->value.brief_description);
-				} else {
-					descr = DTR(E->value.description);
-				}
+			tooltip = tname;
+#endif
+			if (task_meta.begins_with("res:")) {
+				pending_icons.push_back(sec->add_task_button(tname, script_icon, tooltip, task_meta));
+			} else {
+				sec->add_task_button(tname, LimboUtility::get_singleton()->get_task_icon(task_meta), tooltip, task_meta);
 			}
-#endif // LIMBOAI_MODULE
-
-			// TODO: Documentation tooltips are only available in the module. Find a way to show em in GDExtension.
-
-			sec->add_task_button(tname, icon, descr, task_meta);
 		}
 		sec->set_filter("");
 		sec->connect(LW_NAME(task_button_pressed), callable_mp(this, &TaskPalette::_on_task_button_pressed));
@@ -479,6 +488,35 @@ void TaskPalette::refresh() {
 	if (!dialog_mode && !filter_edit->get_text().is_empty()) {
 		_apply_filter(filter_edit->get_text());
 	}
+
+	if (!pending_icons.is_empty()) {
+		call_deferred(LW_NAME(_resolve_pending_icons));
+	}
+}
+
+void TaskPalette::refresh_if_outdated() {
+	LimboTaskDB::scan_user_tasks();
+	if (sections->get_child_count() == 0 || tasks_revision != LimboTaskDB::get_revision()) {
+		refresh();
+	}
+}
+
+void TaskPalette::_resolve_pending_icons() {
+	static constexpr uint32_t ICONS_PER_FRAME = 8;
+	uint32_t count = MIN(ICONS_PER_FRAME, pending_icons.size());
+	for (uint32_t i = 0; i < count; i++) {
+		TaskButton *btn = pending_icons[pending_icons.size() - 1];
+		pending_icons.resize(pending_icons.size() - 1);
+		BUTTON_SET_ICON(btn, LimboUtility::get_singleton()->get_task_icon(btn->get_task_meta()));
+	}
+	if (!pending_icons.is_empty()) {
+		call_deferred(LW_NAME(_resolve_pending_icons));
+	}
+}
+
+void TaskPalette::_on_refresh_pressed() {
+	LimboTaskDB::mark_user_tasks_dirty();
+	refresh();
 }
 
 void TaskPalette::use_dialog_mode() {
@@ -502,7 +540,7 @@ void TaskPalette::_notification(int p_what) {
 			// **** Signals
 			tool_filters->connect(LW_NAME(pressed), callable_mp(this, &TaskPalette::_show_filter_popup));
 			filter_edit->connect(LW_NAME(text_changed), callable_mp(this, &TaskPalette::_apply_filter));
-			tool_refresh->connect(LW_NAME(pressed), callable_mp(this, &TaskPalette::refresh));
+			tool_refresh->connect(LW_NAME(pressed), callable_mp(this, &TaskPalette::_on_refresh_pressed));
 			menu->connect(LW_NAME(id_pressed), callable_mp(this, &TaskPalette::_menu_action_selected));
 			type_all->connect(LW_NAME(pressed), callable_mp(this, &TaskPalette::_type_filter_changed));
 			type_core->connect(LW_NAME(pressed), callable_mp(this, &TaskPalette::_type_filter_changed));
@@ -590,6 +628,7 @@ void TaskPalette::_notification(int p_what) {
 
 void TaskPalette::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("refresh"), &TaskPalette::refresh);
+	ClassDB::bind_method(D_METHOD("_resolve_pending_icons"), &TaskPalette::_resolve_pending_icons);
 
 	ADD_SIGNAL(MethodInfo("task_selected"));
 	ADD_SIGNAL(MethodInfo("favorite_tasks_changed"));
@@ -15,6 +15,7 @@
 #define TASK_PALETTE_H
 
 #ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
 #include "scene/gui/box_container.h"
 #include "scene/gui/button.h"
 #include "scene/gui/check_box.h"
@@ -35,6 +36,7 @@
 #include <godot_cpp/classes/texture2d.hpp>
 #include <godot_cpp/classes/v_box_container.hpp>
 #include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
@@ -42,12 +44,17 @@ class TaskButton : public Button {
 	GDCLASS(TaskButton, Button);
 
 private:
+	String task_meta;
+
 	Control *_do_make_tooltip(const String &p_text) const;
 
 protected:
 	static void _bind_methods();
 
 public:
+	void set_task_meta(const String &p_task_meta) { task_meta = p_task_meta; }
+	String get_task_meta() const { return task_meta; }
+
 #ifdef LIMBOAI_MODULE
 	virtual Control *make_custom_tooltip(const String &p_text) const override { return _do_make_tooltip(p_text); }
 #elif LIMBOAI_GDEXTENSION
@@ -82,7 +89,7 @@ protected:
 
 public:
 	void set_filter(String p_filter);
-	void add_task_button(const String &p_name, const Ref<Texture> &icon, const String &p_tooltip, Variant p_meta);
+	TaskButton *add_task_button(const String &p_name, const Ref<Texture> &icon, const String &p_tooltip, Variant p_meta);
 
 	void set_collapsed(bool p_collapsed);
 	bool is_collapsed() const;
@@ -152,6 +159,11 @@ private:
 	String context_task;
 	bool dialog_mode = false;
 
+	// LimboTaskDB revision the palette was last built from.
+	uint32_t tasks_revision = 0;
+	// Icons of user tasks are resolved a few at a time after the palette is built, as that requires loading scripts.
+	LocalVector<TaskButton *> pending_icons;
+
 	void _menu_action_selected(int p_id);
 	void _on_task_button_pressed(const String &p_task);
 	void _on_task_button_rmb(const String &p_task);
@@ -165,6 +177,8 @@ private:
 	void _filter_data_changed();
 	void _draw_filter_popup_background();
 	void _update_filter_button();
+	void _resolve_pending_icons();
+	void _on_refresh_pressed();
 
 	_FORCE_INLINE_ void _set_category_excluded(const String &p_category, bool p_excluded) {
 		if (p_excluded) {
@@ -182,6 +196,7 @@ protected:
 
 public:
 	void refresh();
+	void refresh_if_outdated();
 	void use_dialog_mode();
 	void clear_filter() { filter_edit->set_text(""); }
 
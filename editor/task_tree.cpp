@@ -17,15 +17,18 @@
 #include "../bt/tasks/composites/bt_probability_selector.h"
 #include "../util/limbo_compat.h"
 #include "../util/limbo_utility.h"
+#include "lazy_tree_items.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/script_language.h"
+#include "core/os/time.h"
 #include "editor/editor_scale.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/editor_interface.hpp>
 #include <godot_cpp/classes/script.hpp>
+#include <godot_cpp/classes/time.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
@@ -35,13 +38,134 @@ TreeItem *TaskTree::_create_tree(const Ref<BTTask> &p_task, TreeItem *p_parent,
 	ERR_FAIL_COND_V(p_task.is_null(), nullptr);
 	TreeItem *item = tree->create_item(p_parent, p_idx);
 	item->set_metadata(0, p_task);
-	for (int i = 0; i < p_task->get_child_count(); i++) {
-		_create_tree(p_task->get_child(i), item);
+	item_index[p_task.ptr()] = item;
+	Callable on_task_changed = callable_mp(this, &TaskTree::_on_task_changed).bind(uint64_t(p_task->get_instance_id()));
+	if (!p_task->is_connected(LW_NAME(changed), on_task_changed)) {
+		// * Task may have moved and still be connected through its previous item.
+		p_task->connect(LW_NAME(changed), on_task_changed);
 	}
+	// * Updated before its children, so they can tell if they are inside a collapsed branch.
 	_update_item(item);
+	if (item->is_collapsed() && p_task->get_child_count() > 0) {
+		// * Children of a collapsed branch are created once it is expanded.
+		TreeItem *placeholder = LazyTreeItems::add_placeholder(tree, item);
+		placeholder->set_metadata(1, p_task->get_child_count());
+	} else {
+		for (int i = 0; i < p_task->get_child_count(); i++) {
+			_create_tree(p_task->get_child(i), item);
+		}
+	}
 	return item;
 }
 
+void TaskTree::_materialize_children(TreeItem *p_item) {
+	Ref<BTTask> task = p_item->get_metadata(0);
+	ERR_FAIL_COND(task.is_null());
+	LazyTreeItems::remove_placeholder(p_item);
+	bool was_updating = updating_tree;
+	updating_tree = true;
+	for (int i = 0; i < task->get_child_count(); i++) {
+		_create_tree(task->get_child(i), p_item);
+	}
+	updating_tree = was_updating;
+}
+
+// Brings the children of p_item in line with the children of p_task, reusing existing items.
+void TaskTree::_sync_children(TreeItem *p_item, const Ref<BTTask> &p_task) {
+	if (LazyTreeItems::has_placeholder(p_item)) {
+		// * Branch is not materialized: only its own item may need an update.
+		TreeItem *placeholder = p_item->get_first_child();
+		if ((int)placeholder->get_metadata(1) != p_task->get_child_count()) {
+			if (p_task->get_child_count() == 0) {
+				LazyTreeItems::remove_placeholder(p_item);
+			} else {
+				placeholder->set_metadata(1, p_task->get_child_count());
+			}
+			_update_item(p_item);
+		}
+		return;
+	}
+
+	bool changed = false;
+	TreeItem *child_item = p_item->get_first_child();
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		Ref<BTTask> child = p_task->get_child(i);
+		TreeItem **existing = item_index.getptr(child.ptr());
+		if (existing && *existing == child_item) {
+			_sync_children(child_item, child);
+			child_item = child_item->get_next();
+			continue;
+		}
+
+		changed = true;
+		if (existing && (*existing)->get_parent() == p_item) {
+			// * Moved within the same parent: found further down the list.
+			TreeItem *moved = *existing;
+			moved->move_before(child_item);
+			_update_item(moved);
+			_sync_children(moved, child);
+		} else {
+			// * Added or moved from another parent.
+			_create_tree(child, p_item, i);
+		}
+	}
+
+	// * Remaining items belong to tasks that were removed from p_task.
+	while (child_item) {
+		TreeItem *next = child_item->get_next();
+		_free_item(child_item);
+		child_item = next;
+		changed = true;
+	}
+
+	if (changed) {
+		_update_item(p_item);
+	}
+}
+
+void TaskTree::_free_item(TreeItem *p_item) {
+	List<TreeItem *> stack;
+	stack.push_back(p_item);
+	while (!stack.is_empty()) {
+		TreeItem *item = stack.front()->get();
+		stack.pop_front();
+		Ref<BTTask> task = item->get_metadata(0);
+		TreeItem **indexed = item_index.getptr(task.ptr());
+		if (indexed && *indexed == item) {
+			// * Task may have moved elsewhere and already have a new item.
+			item_index.erase(task.ptr());
+			_release_task(task);
+		}
+		warnings_pending.erase(item);
+		warnings_queued.erase(item);
+		for (TreeItem *child = item->get_first_child(); child; child = child->get_next()) {
+			stack.push_back(child);
+		}
+	}
+	memdelete(p_item);
+}
+
+// Disconnects a task that no longer has an item and drops its cached name.
+void TaskTree::_release_task(const Ref<BTTask> &p_task) {
+	Callable on_task_changed = callable_mp(this, &TaskTree::_on_task_changed).bind(uint64_t(p_task->get_instance_id()));
+	if (p_task->is_connected(LW_NAME(changed), on_task_changed)) {
+		p_task->disconnect(LW_NAME(changed), on_task_changed);
+	}
+	LimboUtility::get_singleton()->invalidate_task_name(p_task);
+}
+
+void TaskTree::_clear_tree() {
+	for (const KeyValue<const BTTask *, TreeItem *> &kv : item_index) {
+		_release_task(kv.value->get_metadata(0));
+	}
+	tree->clear();
+	item_index.clear();
+	warnings_pending.clear();
+	warnings_queue.clear();
+	warnings_queue_pos = 0;
+	warnings_queued.clear();
+}
+
 void TaskTree::_update_item(TreeItem *p_item) {
 	if (p_item == nullptr) {
 		return;
@@ -57,7 +181,7 @@ void TaskTree::_update_item(TreeItem *p_item) {
 
 	Ref<BTTask> task = p_item->get_metadata(0);
 	ERR_FAIL_COND_MSG(!task.is_valid(), "Invalid task reference in metadata.");
-	p_item->set_text(0, task->get_task_name());
+	p_item->set_text(0, LimboUtility::get_singleton()->get_task_name_cached(task));
 	if (IS_CLASS(task, BTComment)) {
 		p_item->set_custom_font(0, theme_cache.comment_font);
 		p_item->set_custom_color(0, theme_cache.comment_color);
@@ -82,6 +206,29 @@ void TaskTree::_update_item(TreeItem *p_item) {
 	p_item->set_icon_max_width(0, 16 * EDSCALE);
 	p_item->set_editable(0, false);
 	p_item->set_collapsed(task->is_displayed_collapsed());
+	if (!p_item->is_collapsed() && LazyTreeItems::has_placeholder(p_item)) {
+		_materialize_children(p_item);
+	}
+
+	// * Warnings may call into scripts, so they are skipped for items hidden in collapsed branches.
+	for (TreeItem *parent = p_item->get_parent(); parent; parent = parent->get_parent()) {
+		if (parent->is_collapsed()) {
+			warnings_pending.insert(p_item);
+			return;
+		}
+	}
+	if (updating_tree) {
+		_queue_warnings(p_item);
+	} else {
+		_update_warnings(p_item);
+	}
+}
+
+void TaskTree::_update_warnings(TreeItem *p_item) {
+	warnings_pending.erase(p_item);
+	warnings_queued.erase(p_item);
+	Ref<BTTask> task = p_item->get_metadata(0);
+	ERR_FAIL_COND(task.is_null());
 
 	for (int i = 0; i < p_item->get_button_count(0); i++) {
 		p_item->erase_button(0, i);
@@ -100,46 +247,108 @@ void TaskTree::_update_item(TreeItem *p_item) {
 	}
 }
 
-void TaskTree::_update_tree() {
-	Ref<BTTask> sel;
-	if (tree->get_selected()) {
-		sel = tree->get_selected()->get_metadata(0);
+void TaskTree::_update_pending_warnings(TreeItem *p_item) {
+	for (TreeItem *child = p_item->get_first_child(); child; child = child->get_next()) {
+		if (warnings_pending.has(child)) {
+			_update_warnings(child);
+		}
+		if (!child->is_collapsed()) {
+			_update_pending_warnings(child);
+		}
 	}
+}
 
-	tree->clear();
-	if (bt.is_null()) {
+void TaskTree::_queue_warnings(TreeItem *p_item) {
+	if (!warnings_queued.has(p_item)) {
+		warnings_queued.insert(p_item);
+		warnings_queue.push_back(p_item);
+		set_process(true);
+	}
+}
+
+void TaskTree::_process_warnings_queue() {
+	// * Warnings may call into scripts, so they are spread across frames within a time budget.
+	const uint64_t deadline = Time::get_singleton()->get_ticks_usec() + 4000;
+	while (warnings_queue_pos < warnings_queue.size()) {
+		TreeItem *item = warnings_queue[warnings_queue_pos++];
+		// * Items that were freed or updated in the meantime are no longer in the set.
+		if (warnings_queued.has(item)) {
+			_update_warnings(item);
+		}
+		if (Time::get_singleton()->get_ticks_usec() >= deadline) {
+			return;
+		}
+	}
+	warnings_queue.clear();
+	warnings_queue_pos = 0;
+	warnings_queued.clear();
+	set_process(false);
+}
+
+void TaskTree::_update_tree() {
+	if (bt.is_null() || bt->get_root_task().is_null()) {
+		_clear_tree();
 		return;
 	}
 
-	if (bt->get_root_task().is_valid()) {
-		updating_tree = true;
-		_create_tree(bt->get_root_task(), nullptr);
-		updating_tree = false;
+	Ref<BTTask> sel = get_selected();
+	Ref<BTTask> root_task = bt->get_root_task();
+
+	updating_tree = true;
+	if (tree->get_root() == nullptr || _find_item(root_task) != tree->get_root()) {
+		_clear_tree();
+		_create_tree(root_task, nullptr);
+	} else {
+		_sync_children(tree->get_root(), root_task);
 	}
+	updating_tree = false;
 
-	TreeItem *item = _find_item(sel);
-	if (item) {
-		item->select(0);
+	// * Restore selection if the selected item was recreated.
+	if (sel.is_valid() && get_selected() != sel) {
+		TreeItem *item = _find_item(sel);
+		if (item) {
+			item->select(0);
+		}
 	}
 }
 
-TreeItem *TaskTree::_find_item(const Ref<BTTask> &p_task) const {
+// Returns the item of p_task, creating items of the collapsed branches that contain it if needed.
+TreeItem *TaskTree::_find_item(const Ref<BTTask> &p_task) {
 	if (p_task.is_null()) {
 		return nullptr;
 	}
-	TreeItem *item = tree->get_root();
-	List<TreeItem *> stack;
-	while (item && item->get_metadata(0) != p_task) {
-		if (item->get_child_count() > 0) {
-			stack.push_back(item->get_first_child());
+	TreeItem *const *item = item_index.getptr(p_task.ptr());
+	if (item) {
+		return *item;
+	}
+
+	// * Find the closest ancestor that has an item, and materialize branches down from it.
+	LocalVector<const BTTask *> ancestors;
+	TreeItem *ancestor_item = nullptr;
+	for (const BTTask *task = p_task->get_parent().ptr(); task; task = task->get_parent().ptr()) {
+		TreeItem *const *found = item_index.getptr(task);
+		if (found) {
+			ancestor_item = *found;
+			break;
 		}
-		item = item->get_next();
-		if (item == nullptr && !stack.is_empty()) {
-			item = stack.front()->get();
-			stack.pop_front();
+		ancestors.push_back(task);
+	}
+	if (ancestor_item == nullptr) {
+		// * Task doesn't belong to the loaded tree.
+		return nullptr;
+	}
+	if (LazyTreeItems::has_placeholder(ancestor_item)) {
+		_materialize_children(ancestor_item);
+	}
+	for (int i = int(ancestors.size()) - 1; i >= 0; i--) {
+		TreeItem *const *branch = item_index.getptr(ancestors[i]);
+		ERR_FAIL_NULL_V(branch, nullptr);
+		if (LazyTreeItems::has_placeholder(*branch)) {
+			_materialize_children(*branch);
 		}
 	}
-	return item;
+	item = item_index.getptr(p_task.ptr());
+	return item ? *item : nullptr;
 }
 
 void TaskTree::_on_item_mouse_selected(const Vector2 &p_pos, MouseButton p_button_index) {
@@ -154,15 +363,10 @@ void TaskTree::_on_item_mouse_selected(const Vector2 &p_pos, MouseButton p_butto
 }
 
 void TaskTree::_on_item_selected() {
-	Callable on_task_changed = callable_mp(this, &TaskTree::_on_task_changed);
 	if (last_selected.is_valid()) {
 		update_task(last_selected);
-		if (last_selected->is_connected(LW_NAME(changed), on_task_changed)) {
-			last_selected->disconnect(LW_NAME(changed), on_task_changed);
-		}
 	}
 	last_selected = get_selected();
-	last_selected->connect(LW_NAME(changed), on_task_changed);
 	emit_signal(LW_NAME(task_selected), last_selected);
 }
 
@@ -183,22 +387,29 @@ void TaskTree::_on_item_collapsed(Object *p_obj) {
 	Ref<BTTask> task = item->get_metadata(0);
 	ERR_FAIL_NULL(task);
 	task->set_display_collapsed(item->is_collapsed());
+	if (!item->is_collapsed() && LazyTreeItems::has_placeholder(item)) {
+		_materialize_children(item);
+	}
+	if (!item->is_collapsed() && !warnings_pending.is_empty()) {
+		_update_pending_warnings(item);
+	}
 }
 
-void TaskTree::_on_task_changed() {
-	_update_item(tree->get_selected());
+void TaskTree::_on_task_changed(uint64_t p_task_id) {
+	BTTask *task = Object::cast_to<BTTask>(ObjectDB::get_instance(ObjectID(p_task_id)));
+	ERR_FAIL_NULL(task);
+	LimboUtility::get_singleton()->invalidate_task_name(task);
+	TreeItem **item = item_index.getptr(task);
+	if (item) {
+		_update_item(*item);
+	}
 }
 
 void TaskTree::load_bt(const Ref<BehaviorTree> &p_behavior_tree) {
 	ERR_FAIL_COND_MSG(p_behavior_tree.is_null(), "Tried to load a null tree.");
 
-	Callable on_task_changed = callable_mp(this, &TaskTree::_on_task_changed);
-	if (last_selected.is_valid() && last_selected->is_connected(LW_NAME(changed), on_task_changed)) {
-		last_selected->disconnect(LW_NAME(changed), on_task_changed);
-	}
-
 	bt = p_behavior_tree;
-	tree->clear();
+	_clear_tree();
 	probability_rect_cache.clear();
 	if (bt->get_root_task().is_valid()) {
 		updating_tree = true;
@@ -208,23 +419,35 @@ void TaskTree::load_bt(const Ref<BehaviorTree> &p_behavior_tree) {
 }
 
 void TaskTree::unload() {
-	Callable on_task_changed = callable_mp(this, &TaskTree::_on_task_changed);
-	if (last_selected.is_valid() && last_selected->is_connected(LW_NAME(changed), on_task_changed)) {
-		last_selected->disconnect(LW_NAME(changed), on_task_changed);
-	}
-
 	bt.unref();
-	tree->clear();
+	_clear_tree();
 }
 
 void TaskTree::update_task(const Ref<BTTask> &p_task) {
 	ERR_FAIL_COND(p_task.is_null());
+	LimboUtility::get_singleton()->invalidate_task_name(p_task);
 	TreeItem *item = _find_item(p_task);
 	if (item) {
 		_update_item(item);
 	}
 }
 
+// Updates every item, including the ones whose tasks didn't change.
+// Needed when names, icons or warnings change without the tree structure changing, e.g., after scripts are reloaded.
+void TaskTree::refresh_all_items() {
+	// * Updating items may create items for expanded branches, so the index is not iterated directly.
+	LocalVector<TreeItem *> items;
+	items.reserve(item_index.size());
+	for (const KeyValue<const BTTask *, TreeItem *> &kv : item_index) {
+		items.push_back(kv.value);
+	}
+	updating_tree = true;
+	for (TreeItem *item : items) {
+		_update_item(item);
+	}
+	updating_tree = false;
+}
+
 Ref<BTTask> TaskTree::get_selected() const {
 	if (tree->get_selected()) {
 		return tree->get_selected()->get_metadata(0);
@@ -393,6 +616,9 @@ void TaskTree::_notification(int p_what) {
 			_do_update_theme_item_cache();
 			_update_tree();
 		} break;
+		case NOTIFICATION_PROCESS: {
+			_process_warnings_queue();
+		} break;
 	}
 }
 
@@ -437,10 +663,7 @@ TaskTree::TaskTree() {
 }
 
 TaskTree::~TaskTree() {
-	Callable on_task_changed = callable_mp(this, &TaskTree::_on_task_changed);
-	if (last_selected.is_valid() && last_selected->is_connected(LW_NAME(changed), on_task_changed)) {
-		last_selected->disconnect(LW_NAME(changed), on_task_changed);
-	}
+	// * Connections to tasks are dropped along with this object.
 }
 
 #endif // ! TOOLS_ENABLED
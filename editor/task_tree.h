@@ -14,6 +14,8 @@
 #include "../bt/behavior_tree.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "scene/gui/control.h"
 #include "scene/gui/tree.h"
 #include "scene/resources/style_box_flat.h"
@@ -28,6 +30,8 @@
 #include <godot_cpp/classes/texture2d.hpp>
 #include <godot_cpp/classes/tree.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 
 #define RECT_CACHE_KEY uint64_t
 #endif // LIMBOAI_GDEXTENSION
@@ -43,6 +47,15 @@ private:
 	bool updating_tree;
 	HashMap<RECT_CACHE_KEY, Rect2> probability_rect_cache;
 
+	// Tree items by task. Lets _update_tree() reuse items and only touch the parts of the tree that changed.
+	HashMap<const BTTask *, TreeItem *> item_index;
+	// Items inside collapsed branches, whose configuration warnings are evaluated when they become visible.
+	HashSet<TreeItem *> warnings_pending;
+	// Visible items whose warnings are evaluated over the next frames, so that loading a large tree doesn't stall the editor.
+	LocalVector<TreeItem *> warnings_queue;
+	uint32_t warnings_queue_pos = 0;
+	HashSet<TreeItem *> warnings_queued;
+
 	struct ThemeCache {
 		Ref<Font> comment_font;
 		Ref<Font> name_font;
@@ -62,15 +75,24 @@ private:
 	} theme_cache;
 
 	TreeItem *_create_tree(const Ref<BTTask> &p_task, TreeItem *p_parent, int p_idx = -1);
+	void _materialize_children(TreeItem *p_item);
+	void _sync_children(TreeItem *p_item, const Ref<BTTask> &p_task);
+	void _free_item(TreeItem *p_item);
+	void _release_task(const Ref<BTTask> &p_task);
+	void _clear_tree();
 	void _update_item(TreeItem *p_item);
+	void _update_warnings(TreeItem *p_item);
+	void _update_pending_warnings(TreeItem *p_item);
+	void _queue_warnings(TreeItem *p_item);
+	void _process_warnings_queue();
 	void _update_tree();
-	TreeItem *_find_item(const Ref<BTTask> &p_task) const;
+	TreeItem *_find_item(const Ref<BTTask> &p_task);
 
 	void _on_item_selected();
 	void _on_item_activated();
 	void _on_item_collapsed(Object *p_obj);
 	void _on_item_mouse_selected(const Vector2 &p_pos, MouseButton p_button_index);
-	void _on_task_changed();
+	void _on_task_changed(uint64_t p_task_id);
 
 	Variant _get_drag_data_fw(const Point2 &p_point);
 	bool _can_drop_data_fw(const Point2 &p_point, const Variant &p_data) const;
@@ -90,6 +112,8 @@ public:
 	Ref<BehaviorTree> get_bt() const { return bt; }
 	void update_tree() { _update_tree(); }
 	void update_task(const Ref<BTTask> &p_task);
+	void refresh_all_items();
+	TreeItem *get_task_item(const Ref<BTTask> &p_task) { return _find_item(p_task); }
 	Ref<BTTask> get_selected() const;
 	void deselect();
 
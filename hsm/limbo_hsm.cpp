@@ -22,27 +22,31 @@ void LimboHSM::set_active(bool p_active) {
 	}
 
 	active = p_active;
+	_set_processing(p_active);
+
+	if (active) {
+		_enter();
+	} else {
+		_exit();
+	}
+}
+
+void LimboHSM::_set_processing(bool p_enabled) {
 	switch (update_mode) {
 		case UpdateMode::IDLE: {
-			set_process(p_active);
+			set_process(p_enabled);
 			set_physics_process(false);
 		} break;
 		case UpdateMode::PHYSICS: {
 			set_process(false);
-			set_physics_process(p_active);
+			set_physics_process(p_enabled);
 		} break;
 		case UpdateMode::MANUAL: {
 			set_process(false);
 			set_physics_process(false);
 		} break;
 	}
-	set_process_input(p_active);
-
-	if (active) {
-		_enter();
-	} else {
-		_exit();
-	}
+	set_process_input(p_enabled);
 }
 
 void LimboHSM::_change_state(LimboState *p_state) {
@@ -88,6 +92,9 @@ void LimboHSM::_update(double p_delta) {
 }
 
 void LimboHSM::update(double p_delta) {
+	if (!event_queues[event_queue_back].is_empty()) {
+		_process_event_queue();
+	}
 	updating = true;
 	_update(p_delta);
 	updating = false;
@@ -97,14 +104,240 @@ void LimboHSM::update(double p_delta) {
 	}
 }
 
+void LimboHSM::set_queue_events(bool p_enabled) {
+	if (queue_events == p_enabled) {
+		return;
+	}
+	queue_events = p_enabled;
+	if (!queue_events && !event_queues[event_queue_back].is_empty()) {
+		_process_event_queue();
+	}
+}
+
+void LimboHSM::reset_queue_stats() {
+	peak_queue_depth = event_queues[event_queue_back].size();
+	coalesced_event_count = 0;
+}
+
+void LimboHSM::_enqueue_event(const StringName &p_event, const Variant &p_cargo) {
+	ERR_FAIL_COND(p_event == StringName());
+
+	LocalVector<QueuedEvent> &queue = event_queues[event_queue_back];
+	const uint32_t *idx = queued_event_index.getptr(p_event);
+	if (idx) {
+		// Coalesce: the event keeps its place in the queue, and the latest cargo wins.
+		queue[*idx].cargo = p_cargo;
+		coalesced_event_count += 1;
+		return;
+	}
+
+	queued_event_index.insert(p_event, queue.size());
+	QueuedEvent qe;
+	qe.event = p_event;
+	qe.cargo = p_cargo;
+	queue.push_back(qe);
+	peak_queue_depth = MAX(peak_queue_depth, int(queue.size()));
+}
+
+void LimboHSM::_process_event_queue() {
+	if (processing_queue) {
+		return;
+	}
+	processing_queue = true;
+
+	LocalVector<QueuedEvent> &batch = event_queues[event_queue_back];
+	event_queue_back ^= 1;
+	queued_event_index.clear();
+
+	for (uint32_t i = 0; i < batch.size(); i++) {
+		if (!active) {
+			// State machine finished: drop remaining events.
+			break;
+		}
+		_dispatch(batch[i].event, batch[i].cargo);
+	}
+	batch.clear();
+
+	processing_queue = false;
+}
+
 void LimboHSM::add_transition(LimboState *p_from_state, LimboState *p_to_state, const StringName &p_event) {
 	ERR_FAIL_COND_MSG(p_from_state != nullptr && p_from_state->get_parent() != this, "LimboHSM: Unable to add a transition from a state that is not an immediate child of mine.");
 	ERR_FAIL_COND_MSG(p_to_state == nullptr, "LimboHSM: Unable to add a transition to a null state.");
 	ERR_FAIL_COND_MSG(p_to_state->get_parent() != this, "LimboHSM: Unable to add a transition to a state that is not an immediate child of mine.");
 	ERR_FAIL_COND_MSG(p_event == StringName(), "LimboHSM: Failed to add transition due to empty event string.");
 
-	uint64_t key = _get_transition_key(p_from_state, p_event);
-	transitions[key] = Object::cast_to<LimboState>(p_to_state);
+	ObjectID from_id = p_from_state ? ObjectID(p_from_state->get_instance_id()) : ObjectID();
+	for (Transition &t : transitions) {
+		if (t.from_id == from_id && t.event == p_event) {
+			t.to_id = ObjectID(p_to_state->get_instance_id());
+			_invalidate_root_tables();
+			return;
+		}
+	}
+	Transition t;
+	t.from_id = from_id;
+	t.to_id = ObjectID(p_to_state->get_instance_id());
+	t.event = p_event;
+	transitions.push_back(t);
+	_invalidate_root_tables();
+}
+
+static constexpr uint32_t STATE_MAGIC = 0x4D53484C; // "LHSM"
+static constexpr uint8_t STATE_VERSION = 1;
+
+// Clears the active chain below this HSM without calling exit callbacks.
+void LimboHSM::_reset_state() {
+	if (active_state) {
+		active_state->active = false;
+		active_state->_reset_state();
+		active_state = nullptr;
+	}
+	next_active = nullptr;
+}
+
+void LimboHSM::_save_state(LimboBinaryWriter &p_writer) const {
+	p_writer.put_i32(active_state ? active_state->get_index() : -1);
+	p_writer.put_i32(previous_active ? previous_active->get_index() : -1);
+	if (active_state) {
+		active_state->_save_state(p_writer);
+	}
+}
+
+void LimboHSM::_load_state(LimboBinaryReader &p_reader) {
+	int active_index = p_reader.get_i32();
+	int previous_index = p_reader.get_i32();
+	LimboState *new_active = active_index >= 0 && active_index < get_child_count() ? Object::cast_to<LimboState>(get_child(active_index)) : nullptr;
+	LimboState *new_previous = previous_index >= 0 && previous_index < get_child_count() ? Object::cast_to<LimboState>(get_child(previous_index)) : nullptr;
+	if (p_reader.has_error() || (active_index != -1 && new_active == nullptr) || (previous_index != -1 && new_previous == nullptr)) {
+		p_reader.set_error();
+		return;
+	}
+
+	if (active_state != new_active) {
+		_reset_state();
+	}
+	next_active = nullptr;
+	previous_active = new_previous;
+	active_state = new_active;
+	if (active_state) {
+		active_state->active = true;
+		active_state->_load_state(p_reader);
+	}
+}
+
+void LimboHSM::save_state_to(LimboBinaryWriter &p_writer) const {
+	p_writer.put_u32(STATE_MAGIC);
+	p_writer.put_u8(STATE_VERSION);
+	p_writer.put_u8(active);
+	_save_state(p_writer);
+}
+
+Error LimboHSM::load_state_from(LimboBinaryReader &p_reader) {
+	ERR_FAIL_COND_V_MSG(agent == nullptr, ERR_UNCONFIGURED, "LimboHSM is not initialized.");
+	ERR_FAIL_COND_V_MSG(!is_root(), ERR_UNAVAILABLE, "LimboHSM: load_state() must be called on the root HSM.");
+
+	uint32_t magic = p_reader.get_u32();
+	uint8_t version = p_reader.get_u8();
+	ERR_FAIL_COND_V_MSG(magic != STATE_MAGIC || version != STATE_VERSION, ERR_FILE_UNRECOGNIZED, "LimboHSM: Unrecognized state format.");
+	bool was_active = p_reader.get_u8();
+
+	_load_state(p_reader);
+	ERR_FAIL_COND_V_MSG(p_reader.has_error(), ERR_INVALID_DATA, "LimboHSM: State doesn't match the state machine structure.");
+
+	if (active != was_active) {
+		active = was_active;
+		_set_processing(active);
+	}
+	return OK;
+}
+
+PackedByteArray LimboHSM::save_state() const {
+	LimboBinaryWriter writer;
+	save_state_to(writer);
+	return writer.to_packed();
+}
+
+Error LimboHSM::load_state(const PackedByteArray &p_state) {
+	LimboBinaryReader reader(p_state);
+	return load_state_from(reader);
+}
+
+void LimboHSM::_compile_tables() {
+	event_ids.clear();
+	_collect_events(this);
+	_build_tables(this, event_ids.size());
+	tables_dirty = false;
+}
+
+void LimboHSM::_collect_events(LimboState *p_state) {
+	for (const KeyValue<StringName, Callable> &kv : p_state->handlers) {
+		if (!event_ids.has(kv.key)) {
+			event_ids.insert(kv.key, event_ids.size());
+		}
+	}
+	LimboHSM *hsm = Object::cast_to<LimboHSM>(p_state);
+	if (hsm == nullptr) {
+		return;
+	}
+	for (const Transition &t : hsm->transitions) {
+		if (!event_ids.has(t.event)) {
+			event_ids.insert(t.event, event_ids.size());
+		}
+	}
+	for (int i = 0; i < hsm->get_child_count(); i++) {
+		LimboState *c = Object::cast_to<LimboState>(hsm->get_child(i));
+		if (c) {
+			_collect_events(c);
+		}
+	}
+}
+
+void LimboHSM::_build_tables(LimboState *p_state, int p_num_events) {
+	p_state->handler_table.clear();
+	if (p_state->handlers.size() > 0) {
+		p_state->handler_table.resize(p_num_events);
+		for (const KeyValue<StringName, Callable> &kv : p_state->handlers) {
+			p_state->handler_table[event_ids[kv.key]] = kv.value;
+		}
+	}
+
+	LimboHSM *hsm = Object::cast_to<LimboHSM>(p_state);
+	if (hsm == nullptr) {
+		return;
+	}
+
+	int num_children = hsm->get_child_count();
+	for (int i = 0; i < num_children; i++) {
+		LimboState *c = Object::cast_to<LimboState>(hsm->get_child(i));
+		if (c) {
+			c->hsm_index = i;
+			_build_tables(c, p_num_events);
+		}
+	}
+
+	hsm->table_num_events = p_num_events;
+	hsm->transition_table.resize((num_children + 1) * p_num_events);
+	for (uint32_t i = 0; i < hsm->transition_table.size(); i++) {
+		hsm->transition_table[i] = nullptr;
+	}
+	for (uint32_t i = 0; i < hsm->transitions.size();) {
+		const Transition &t = hsm->transitions[i];
+		LimboState *to_state = Object::cast_to<LimboState>(ObjectDB::get_instance(t.to_id));
+		LimboState *from_state = t.from_id.is_null() ? nullptr : Object::cast_to<LimboState>(ObjectDB::get_instance(t.from_id));
+		if (to_state == nullptr || (from_state == nullptr && !t.from_id.is_null())) {
+			// State was freed after the transition was added.
+			hsm->transitions.remove_at_unordered(i);
+			continue;
+		}
+		i += 1;
+		if (to_state->get_parent() != hsm || (from_state && from_state->get_parent() != hsm)) {
+			// State was removed from this HSM after the transition was added.
+			continue;
+		}
+		int from_index = from_state ? from_state->hsm_index : -1;
+		hsm->transition_table[(from_index + 1) * p_num_events + event_ids[t.event]] = to_state;
+	}
 }
 
 LimboState *LimboHSM::get_leaf_state() const {
@@ -127,31 +360,36 @@ void LimboHSM::set_initial_state(LimboState *p_state) {
 bool LimboHSM::_dispatch(const StringName &p_event, const Variant &p_cargo) {
 	ERR_FAIL_COND_V(p_event == StringName(), false);
 
+	LimboHSM *root = is_root() ? this : Object::cast_to<LimboHSM>(get_root());
+	if (unlikely(root == nullptr)) {
+		root = this;
+	}
+	if (root->tables_dirty) {
+		root->_compile_tables();
+	}
+	const int *id = root->event_ids.getptr(p_event);
+	return _dispatch_compiled(id ? *id : -1, p_event, p_cargo);
+}
+
+bool LimboHSM::_dispatch_compiled(int p_event_id, const StringName &p_event, const Variant &p_cargo) {
 	bool event_consumed = false;
 
 	if (active_state) {
-		event_consumed = active_state->_dispatch(p_event, p_cargo);
+		event_consumed = active_state->_dispatch_compiled(p_event_id, p_event, p_cargo);
 	}
 
 	if (!event_consumed) {
-		event_consumed = LimboState::_dispatch(p_event, p_cargo);
+		event_consumed = LimboState::_dispatch_compiled(p_event_id, p_event, p_cargo);
 	}
 
-	if (!event_consumed && active_state) {
-		uint64_t key = _get_transition_key(active_state, p_event);
-		LimboState *to_state = nullptr;
-		if (transitions.has(key)) {
-			to_state = transitions[key];
-		}
+	if (!event_consumed && active_state && p_event_id >= 0 && p_event_id < table_num_events) {
+		LimboState *to_state = _get_transition(active_state->hsm_index, p_event_id);
 		if (to_state == nullptr) {
 			// Get ANYSTATE transition.
-			key = _get_transition_key(nullptr, p_event);
-			if (transitions.has(key)) {
-				to_state = transitions[key];
-				if (to_state == active_state) {
-					// Transitions to self are not allowed with ANYSTATE.
-					to_state = nullptr;
-				}
+			to_state = _get_transition(-1, p_event_id);
+			if (to_state == active_state) {
+				// Transitions to self are not allowed with ANYSTATE.
+				to_state = nullptr;
 			}
 		}
 		if (to_state != nullptr) {
@@ -225,16 +463,30 @@ void LimboHSM::_initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard) {
 			c->_initialize(agent, blackboard);
 		}
 	}
+
+	if (is_root()) {
+		// Handlers and transitions added in _setup() are in place now.
+		_compile_tables();
+	}
 }
 
 void LimboHSM::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_POST_ENTER_TREE: {
 		} break;
+		case NOTIFICATION_CHILD_ORDER_CHANGED: {
+			_invalidate_root_tables();
+		} break;
 		case NOTIFICATION_PROCESS: {
+			if (!event_queues[event_queue_back].is_empty()) {
+				_process_event_queue();
+			}
 			_update(get_process_delta_time());
 		} break;
 		case NOTIFICATION_PHYSICS_PROCESS: {
+			if (!event_queues[event_queue_back].is_empty()) {
+				_process_event_queue();
+			}
 			_update(get_physics_process_delta_time());
 		} break;
 	}
@@ -255,6 +507,16 @@ void LimboHSM::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_transition", "from_state", "to_state", "event"), &LimboHSM::add_transition);
 	ClassDB::bind_method(D_METHOD("anystate"), &LimboHSM::anystate);
 
+	ClassDB::bind_method(D_METHOD("set_queue_events", "enabled"), &LimboHSM::set_queue_events);
+	ClassDB::bind_method(D_METHOD("get_queue_events"), &LimboHSM::get_queue_events);
+	ClassDB::bind_method(D_METHOD("get_queued_event_count"), &LimboHSM::get_queued_event_count);
+	ClassDB::bind_method(D_METHOD("get_peak_queue_depth"), &LimboHSM::get_peak_queue_depth);
+	ClassDB::bind_method(D_METHOD("get_coalesced_event_count"), &LimboHSM::get_coalesced_event_count);
+	ClassDB::bind_method(D_METHOD("reset_queue_stats"), &LimboHSM::reset_queue_stats);
+
+	ClassDB::bind_method(D_METHOD("save_state"), &LimboHSM::save_state);
+	ClassDB::bind_method(D_METHOD("load_state", "state"), &LimboHSM::load_state);
+
 	ClassDB::bind_method(D_METHOD("initialize", "agent", "parent_scope"), &LimboHSM::initialize, Variant());
 
 	BIND_ENUM_CONSTANT(IDLE);
@@ -262,6 +524,7 @@ void LimboHSM::_bind_methods() {
 	BIND_ENUM_CONSTANT(MANUAL);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle, Physics, Manual"), "set_update_mode", "get_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "queue_events"), "set_queue_events", "get_queue_events");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "ANYSTATE", PROPERTY_HINT_RESOURCE_TYPE, "LimboState", 0), "", "anystate");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "initial_state", PROPERTY_HINT_RESOURCE_TYPE, "LimboState", 0), "set_initial_state", "get_initial_state");
 
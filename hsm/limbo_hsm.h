@@ -16,6 +16,7 @@
 
 class LimboHSM : public LimboState {
 	GDCLASS(LimboHSM, LimboState);
+	friend LimboState;
 
 public:
 	enum UpdateMode : unsigned int {
@@ -30,16 +31,49 @@ private:
 	LimboState *active_state;
 	LimboState *previous_active;
 	LimboState *next_active;
-	HashMap<uint64_t, LimboState *> transitions;
 	bool updating = false;
 
-	_FORCE_INLINE_ uint64_t _get_transition_key(LimboState *p_from_state, const StringName &p_event) {
-		uint64_t key = hash_djb2_one_64(Variant::OBJECT);
-		if (p_from_state != nullptr) {
-			key = hash_djb2_one_64(hash_one_uint64(hash_make_uint64_t(p_from_state)), key);
-		}
-		key = hash_djb2_one_64(p_event.hash(), key);
-		return key;
+	// States are referenced by ID, as they can be freed while the transition is stored.
+	struct Transition {
+		ObjectID from_id; // Null for ANYSTATE.
+		ObjectID to_id;
+		StringName event;
+	};
+	LocalVector<Transition> transitions;
+
+	// Dense transition table compiled from `transitions`: one row per child state plus a leading ANYSTATE row,
+	// one column per event ID.
+	LocalVector<LimboState *> transition_table;
+	int table_num_events = 0;
+
+	// Event IDs are interned per hierarchy and stored in the root HSM only.
+	HashMap<StringName, int> event_ids;
+	bool tables_dirty = true;
+
+	void _compile_tables();
+	void _collect_events(LimboState *p_state);
+	void _build_tables(LimboState *p_state, int p_num_events);
+
+	struct QueuedEvent {
+		StringName event;
+		Variant cargo;
+	};
+	bool queue_events = false;
+	// Double-buffered: events dispatched while a batch is processed go to the other buffer.
+	LocalVector<QueuedEvent> event_queues[2];
+	uint32_t event_queue_back = 0;
+	bool processing_queue = false;
+	HashMap<StringName, uint32_t> queued_event_index;
+	int peak_queue_depth = 0;
+	uint64_t coalesced_event_count = 0;
+
+	void _enqueue_event(const StringName &p_event, const Variant &p_cargo);
+	void _process_event_queue();
+
+	void _set_processing(bool p_enabled);
+
+	_FORCE_INLINE_ LimboState *_get_transition(int p_from_index, int p_event_id) const {
+		return transition_table[(p_from_index + 1) * table_num_events + p_event_id];
 	}
 
 protected:
@@ -49,11 +83,16 @@ protected:
 
 	virtual void _initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard) override;
 	virtual bool _dispatch(const StringName &p_event, const Variant &p_cargo = Variant()) override;
+	virtual bool _dispatch_compiled(int p_event_id, const StringName &p_event, const Variant &p_cargo) override;
 
 	virtual void _enter() override;
 	virtual void _exit() override;
 	virtual void _update(double p_delta) override;
 
+	virtual void _save_state(LimboBinaryWriter &p_writer) const override;
+	virtual void _load_state(LimboBinaryReader &p_reader) override;
+	virtual void _reset_state() override;
+
 	void _change_state(LimboState *p_state);
 
 public:
@@ -71,9 +110,22 @@ public:
 	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_parent_scope = nullptr);
 
 	void update(double p_delta);
+
+	void set_queue_events(bool p_enabled);
+	bool get_queue_events() const { return queue_events; }
+	int get_queued_event_count() const { return event_queues[event_queue_back].size(); }
+	int get_peak_queue_depth() const { return peak_queue_depth; }
+	int64_t get_coalesced_event_count() const { return coalesced_event_count; }
+	void reset_queue_stats();
+
 	void add_transition(LimboState *p_from_state, LimboState *p_to_state, const StringName &p_event);
 	LimboState *anystate() const { return nullptr; }
 
+	void save_state_to(LimboBinaryWriter &p_writer) const;
+	Error load_state_from(LimboBinaryReader &p_reader);
+	PackedByteArray save_state() const;
+	Error load_state(const PackedByteArray &p_state);
+
 	LimboHSM();
 };
 
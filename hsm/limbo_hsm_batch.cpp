@@ -0,0 +1,306 @@
+/**
+ * limbo_hsm_batch.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_hsm_batch.h"
+
+#include "../util/limbo_compat.h"
+#include "../util/limbo_string_names.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/error/error_macros.h"
+#include "core/object/class_db.h"
+#endif // LIMBOAI_MODULE
+
+VARIANT_ENUM_CAST(LimboHSMBatch::UpdateMode);
+
+void LimboHSMBatch::set_definition(const Ref<LimboHSMDefinition> &p_definition) {
+	if (definition == p_definition) {
+		return;
+	}
+	// State indices are only meaningful within one definition.
+	clear();
+	definition = p_definition;
+}
+
+void LimboHSMBatch::set_update_mode(UpdateMode p_mode) {
+	update_mode = p_mode;
+	_update_process_mode();
+}
+
+void LimboHSMBatch::_update_process_mode() {
+	set_process(update_mode == UpdateMode::IDLE);
+	set_physics_process(update_mode == UpdateMode::PHYSICS);
+}
+
+int LimboHSMBatch::add_instance(Object *p_agent) {
+	ERR_FAIL_COND_V_MSG(definition.is_null(), -1, "LimboHSMBatch: Definition is not set.");
+	definition->compile();
+	ERR_FAIL_COND_V_MSG(definition->initial_state == -1, -1, "LimboHSMBatch: Definition has no states.");
+
+	int idx;
+	if (free_slots.size() > 0) {
+		idx = free_slots[free_slots.size() - 1];
+		free_slots.remove_at(free_slots.size() - 1);
+	} else {
+		idx = instances.size();
+		instances.push_back(Instance());
+	}
+
+	Instance &inst = instances[idx];
+	inst.agent = p_agent;
+	inst.leaf = -1;
+	inst.alive = true;
+	inst.active = true;
+	num_alive += 1;
+
+	_enter_state(idx, definition->initial_state);
+	return idx;
+}
+
+void LimboHSMBatch::remove_instance(int p_instance) {
+	ERR_FAIL_INDEX(p_instance, int(instances.size()));
+	ERR_FAIL_COND_MSG(!instances[p_instance].alive, "LimboHSMBatch: Instance was already removed.");
+	instances[p_instance] = Instance();
+	free_slots.push_back(p_instance);
+	num_alive -= 1;
+}
+
+void LimboHSMBatch::clear() {
+	instances.clear();
+	free_slots.clear();
+	num_alive = 0;
+}
+
+bool LimboHSMBatch::is_instance_active(int p_instance) const {
+	ERR_FAIL_INDEX_V(p_instance, int(instances.size()), false);
+	return instances[p_instance].alive && instances[p_instance].active;
+}
+
+Variant LimboHSMBatch::get_instance_agent(int p_instance) const {
+	ERR_FAIL_INDEX_V(p_instance, int(instances.size()), Variant());
+	return instances[p_instance].agent;
+}
+
+int LimboHSMBatch::get_active_state(int p_instance) const {
+	ERR_FAIL_INDEX_V(p_instance, int(instances.size()), -1);
+	return instances[p_instance].leaf;
+}
+
+bool LimboHSMBatch::is_in_state(int p_instance, int p_state) const {
+	ERR_FAIL_INDEX_V(p_instance, int(instances.size()), false);
+	for (int s = instances[p_instance].leaf; s != -1; s = definition->states[s].parent) {
+		if (s == p_state) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void LimboHSMBatch::_enter_state(int p_instance, int p_state) {
+	const LimboHSMDefinition *def = definition.ptr();
+	for (int s = p_state; s != -1; s = def->states[s].initial_child) {
+		instances[p_instance].leaf = s;
+		const Callable &cb = def->states[s].on_enter;
+		if (cb.is_valid()) {
+			cb.call(instances[p_instance].agent, p_instance);
+			if (unlikely(!instances[p_instance].alive || instances[p_instance].leaf != s)) {
+				// Removed or switched by the callback.
+				return;
+			}
+		}
+	}
+}
+
+void LimboHSMBatch::_exit_to(int p_instance, int p_state) {
+	const LimboHSMDefinition *def = definition.ptr();
+	for (int s = instances[p_instance].leaf; s != -1; s = def->states[s].parent) {
+		const Callable &cb = def->states[s].on_exit;
+		if (cb.is_valid()) {
+			cb.call(instances[p_instance].agent, p_instance);
+		}
+		if (s == p_state) {
+			break;
+		}
+	}
+}
+
+void LimboHSMBatch::_change_state(int p_instance, int p_from_state, int p_to_state) {
+	int prev_leaf = instances[p_instance].leaf;
+	_exit_to(p_instance, p_from_state);
+	_enter_state(p_instance, p_to_state);
+	if (HAS_CONNECTIONS(this, LW_NAME(state_changed))) {
+		emit_signal(LW_NAME(state_changed), p_instance, prev_leaf, instances[p_instance].leaf);
+	}
+}
+
+bool LimboHSMBatch::_dispatch(int p_instance, int p_event_id, const StringName &p_event, const Variant &p_cargo) {
+	const LimboHSMDefinition *def = definition.ptr();
+	const int num_events = def->num_events;
+	const bool has_handlers = !def->handler_table.is_empty();
+
+	if (p_event_id >= 0) {
+		int s = instances[p_instance].leaf;
+		if (has_handlers) {
+			const Callable &h = def->handler_table[s * num_events + p_event_id];
+			if (h.is_valid() && bool(h.call(instances[p_instance].agent, p_instance, p_cargo))) {
+				return true;
+			}
+		}
+		while (true) {
+			// Mirrors LimboHSM: the parent's handler is tried before the parent's transitions.
+			int parent = def->states[s].parent;
+			if (has_handlers && parent != -1) {
+				const Callable &h = def->handler_table[parent * num_events + p_event_id];
+				if (h.is_valid() && bool(h.call(instances[p_instance].agent, p_instance, p_cargo))) {
+					return true;
+				}
+			}
+
+			int to_state = def->transition_table[s * num_events + p_event_id];
+			if (to_state == -1) {
+				to_state = def->anystate_table[(parent + 1) * num_events + p_event_id];
+				if (to_state == s) {
+					// Transitions to self are not allowed with ANYSTATE.
+					to_state = -1;
+				}
+			}
+			if (to_state != -1) {
+				const Callable &guard = def->states[to_state].guard;
+				if (!guard.is_valid() || bool(guard.call(instances[p_instance].agent, p_instance))) {
+					_change_state(p_instance, s, to_state);
+					return true;
+				}
+			}
+
+			if (parent == -1) {
+				break;
+			}
+			s = parent;
+		}
+	}
+
+	if (p_event == LW_NAME(EVENT_FINISHED)) {
+		int top = def->paths[def->path_offsets[instances[p_instance].leaf]];
+		_exit_to(p_instance, top);
+		instances[p_instance].active = false;
+		if (HAS_CONNECTIONS(this, LW_NAME(instance_finished))) {
+			emit_signal(LW_NAME(instance_finished), p_instance);
+		}
+	}
+	return false;
+}
+
+bool LimboHSMBatch::dispatch(int p_instance, const StringName &p_event, const Variant &p_cargo) {
+	ERR_FAIL_COND_V(p_event == StringName(), false);
+	ERR_FAIL_INDEX_V(p_instance, int(instances.size()), false);
+	if (!instances[p_instance].alive || !instances[p_instance].active) {
+		return false;
+	}
+	definition->compile();
+	const int *id = definition->event_ids.getptr(p_event);
+	return _dispatch(p_instance, id ? *id : -1, p_event, p_cargo);
+}
+
+int LimboHSMBatch::dispatch_all(const StringName &p_event, const Variant &p_cargo) {
+	ERR_FAIL_COND_V(p_event == StringName(), 0);
+	if (definition.is_null()) {
+		return 0;
+	}
+	definition->compile();
+	const int *id = definition->event_ids.getptr(p_event);
+	int event_id = id ? *id : -1;
+
+	int num_consumed = 0;
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		if (instances[i].alive && instances[i].active && _dispatch(i, event_id, p_event, p_cargo)) {
+			num_consumed += 1;
+		}
+	}
+	return num_consumed;
+}
+
+void LimboHSMBatch::update(double p_delta) {
+	if (definition.is_null() || num_alive == 0) {
+		return;
+	}
+	definition->compile();
+	const LimboHSMDefinition *def = definition.ptr();
+	if (!def->has_update_callbacks) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		if (!instances[i].alive || !instances[i].active) {
+			continue;
+		}
+		// Update from the top-level state down to the leaf, like nested LimboHSM nodes do.
+		const int leaf = instances[i].leaf;
+		for (uint32_t k = def->path_offsets[leaf]; k < def->path_offsets[leaf + 1]; k++) {
+			const Callable &cb = def->states[def->paths[k]].on_update;
+			if (cb.is_valid()) {
+				cb.call(instances[i].agent, int(i), p_delta);
+				if (!instances[i].alive || !instances[i].active || instances[i].leaf != leaf) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+void LimboHSMBatch::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			_update_process_mode();
+		} break;
+		case NOTIFICATION_PROCESS: {
+			update(get_process_delta_time());
+		} break;
+		case NOTIFICATION_PHYSICS_PROCESS: {
+			update(get_physics_process_delta_time());
+		} break;
+	}
+}
+
+void LimboHSMBatch::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_definition", "definition"), &LimboHSMBatch::set_definition);
+	ClassDB::bind_method(D_METHOD("get_definition"), &LimboHSMBatch::get_definition);
+	ClassDB::bind_method(D_METHOD("set_update_mode", "mode"), &LimboHSMBatch::set_update_mode);
+	ClassDB::bind_method(D_METHOD("get_update_mode"), &LimboHSMBatch::get_update_mode);
+
+	ClassDB::bind_method(D_METHOD("add_instance", "agent"), &LimboHSMBatch::add_instance);
+	ClassDB::bind_method(D_METHOD("remove_instance", "instance"), &LimboHSMBatch::remove_instance);
+	ClassDB::bind_method(D_METHOD("clear"), &LimboHSMBatch::clear);
+	ClassDB::bind_method(D_METHOD("get_instance_count"), &LimboHSMBatch::get_instance_count);
+	ClassDB::bind_method(D_METHOD("is_instance_active", "instance"), &LimboHSMBatch::is_instance_active);
+	ClassDB::bind_method(D_METHOD("get_instance_agent", "instance"), &LimboHSMBatch::get_instance_agent);
+	ClassDB::bind_method(D_METHOD("get_active_state", "instance"), &LimboHSMBatch::get_active_state);
+	ClassDB::bind_method(D_METHOD("is_in_state", "instance", "state"), &LimboHSMBatch::is_in_state);
+
+	ClassDB::bind_method(D_METHOD("dispatch", "instance", "event", "cargo"), &LimboHSMBatch::dispatch, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("dispatch_all", "event", "cargo"), &LimboHSMBatch::dispatch_all, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("update", "delta"), &LimboHSMBatch::update);
+
+	BIND_ENUM_CONSTANT(IDLE);
+	BIND_ENUM_CONSTANT(PHYSICS);
+	BIND_ENUM_CONSTANT(MANUAL);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "definition", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "set_definition", "get_definition");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle, Physics, Manual"), "set_update_mode", "get_update_mode");
+
+	ADD_SIGNAL(MethodInfo("state_changed",
+			PropertyInfo(Variant::INT, "instance"),
+			PropertyInfo(Variant::INT, "from_state"),
+			PropertyInfo(Variant::INT, "to_state")));
+	ADD_SIGNAL(MethodInfo("instance_finished", PropertyInfo(Variant::INT, "instance")));
+}
+
+LimboHSMBatch::LimboHSMBatch() {
+}
@@ -0,0 +1,90 @@
+/**
+ * limbo_hsm_batch.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_HSM_BATCH_H
+#define LIMBO_HSM_BATCH_H
+
+#include "limbo_hsm_definition.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Steps many instances of a LimboHSMDefinition in a single pass.
+// Each instance is a compact record (agent and active leaf state), with no nodes or signals of its own.
+class LimboHSMBatch : public Node {
+	GDCLASS(LimboHSMBatch, Node);
+
+public:
+	enum UpdateMode : unsigned int {
+		IDLE, // automatically call update() during NOTIFICATION_PROCESS
+		PHYSICS, // automatically call update() during NOTIFICATION_PHYSICS
+		MANUAL, // manually update state machines: user must call update(delta)
+	};
+
+private:
+	struct Instance {
+		Variant agent;
+		int leaf = -1;
+		bool alive = false;
+		bool active = false;
+	};
+
+	Ref<LimboHSMDefinition> definition;
+	UpdateMode update_mode = UpdateMode::PHYSICS;
+
+	LocalVector<Instance> instances;
+	LocalVector<int> free_slots;
+	int num_alive = 0;
+
+	void _enter_state(int p_instance, int p_state);
+	void _exit_to(int p_instance, int p_state);
+	void _change_state(int p_instance, int p_from_state, int p_to_state);
+	bool _dispatch(int p_instance, int p_event_id, const StringName &p_event, const Variant &p_cargo);
+	void _update_process_mode();
+
+protected:
+	static void _bind_methods();
+
+	void _notification(int p_what);
+
+public:
+	void set_definition(const Ref<LimboHSMDefinition> &p_definition);
+	Ref<LimboHSMDefinition> get_definition() const { return definition; }
+
+	void set_update_mode(UpdateMode p_mode);
+	UpdateMode get_update_mode() const { return update_mode; }
+
+	int add_instance(Object *p_agent);
+	void remove_instance(int p_instance);
+	void clear();
+	int get_instance_count() const { return num_alive; }
+
+	bool is_instance_active(int p_instance) const;
+	Variant get_instance_agent(int p_instance) const;
+	int get_active_state(int p_instance) const;
+	bool is_in_state(int p_instance, int p_state) const;
+
+	bool dispatch(int p_instance, const StringName &p_event, const Variant &p_cargo = Variant());
+	int dispatch_all(const StringName &p_event, const Variant &p_cargo = Variant());
+	void update(double p_delta);
+
+	LimboHSMBatch();
+};
+
+#endif // LIMBO_HSM_BATCH_H
@@ -0,0 +1,212 @@
+/**
+ * limbo_hsm_definition.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_hsm_definition.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/error/error_macros.h"
+#include "core/object/class_db.h"
+#endif // LIMBOAI_MODULE
+
+int LimboHSMDefinition::add_state(const StringName &p_name, int p_parent) {
+	ERR_FAIL_COND_V_MSG(p_parent < -1 || p_parent >= int(states.size()), -1, "LimboHSMDefinition: Parent state index is out of bounds.");
+
+	State st;
+	st.name = p_name;
+	st.parent = p_parent;
+	states.push_back(st);
+
+	int idx = states.size() - 1;
+	if (p_parent == -1) {
+		if (initial_state == -1) {
+			initial_state = idx;
+		}
+	} else if (states[p_parent].initial_child == -1) {
+		states[p_parent].initial_child = idx;
+	}
+	dirty = true;
+	return idx;
+}
+
+StringName LimboHSMDefinition::get_state_name(int p_state) const {
+	ERR_FAIL_INDEX_V(p_state, int(states.size()), StringName());
+	return states[p_state].name;
+}
+
+int LimboHSMDefinition::get_state_parent(int p_state) const {
+	ERR_FAIL_INDEX_V(p_state, int(states.size()), -1);
+	return states[p_state].parent;
+}
+
+int LimboHSMDefinition::find_state(const StringName &p_name) const {
+	for (uint32_t i = 0; i < states.size(); i++) {
+		if (states[i].name == p_name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void LimboHSMDefinition::set_initial_state(int p_parent, int p_state) {
+	ERR_FAIL_INDEX(p_state, int(states.size()));
+	ERR_FAIL_COND_MSG(states[p_state].parent != p_parent, "LimboHSMDefinition: Initial state must be an immediate child of the parent state.");
+	if (p_parent == -1) {
+		initial_state = p_state;
+	} else {
+		states[p_parent].initial_child = p_state;
+	}
+	dirty = true;
+}
+
+int LimboHSMDefinition::get_initial_state(int p_parent) const {
+	if (p_parent == -1) {
+		return initial_state;
+	}
+	ERR_FAIL_INDEX_V(p_parent, int(states.size()), -1);
+	return states[p_parent].initial_child;
+}
+
+void LimboHSMDefinition::add_transition(int p_from_state, int p_to_state, const StringName &p_event) {
+	ERR_FAIL_INDEX(p_to_state, int(states.size()));
+	ERR_FAIL_COND_MSG(p_from_state != ANYSTATE && (p_from_state < 0 || p_from_state >= int(states.size())), "LimboHSMDefinition: State index is out of bounds.");
+	ERR_FAIL_COND_MSG(p_from_state != ANYSTATE && states[p_from_state].parent != states[p_to_state].parent, "LimboHSMDefinition: Unable to add a transition between states with different parents.");
+	ERR_FAIL_COND_MSG(p_event == StringName(), "LimboHSMDefinition: Failed to add transition due to empty event string.");
+
+	for (Transition &t : transitions) {
+		if (t.from_state == p_from_state && t.event == p_event && (p_from_state != ANYSTATE || states[t.to_state].parent == states[p_to_state].parent)) {
+			t.to_state = p_to_state;
+			dirty = true;
+			return;
+		}
+	}
+
+	Transition t;
+	t.from_state = p_from_state;
+	t.to_state = p_to_state;
+	t.event = p_event;
+	transitions.push_back(t);
+	dirty = true;
+}
+
+void LimboHSMDefinition::add_event_handler(int p_state, const StringName &p_event, const Callable &p_handler) {
+	ERR_FAIL_INDEX(p_state, int(states.size()));
+	ERR_FAIL_COND(p_event == StringName());
+	ERR_FAIL_COND(!p_handler.is_valid());
+	states[p_state].handlers.insert(p_event, p_handler);
+	dirty = true;
+}
+
+void LimboHSMDefinition::set_on_enter(int p_state, const Callable &p_callable) {
+	ERR_FAIL_INDEX(p_state, int(states.size()));
+	states[p_state].on_enter = p_callable;
+}
+
+void LimboHSMDefinition::set_on_exit(int p_state, const Callable &p_callable) {
+	ERR_FAIL_INDEX(p_state, int(states.size()));
+	states[p_state].on_exit = p_callable;
+}
+
+void LimboHSMDefinition::set_on_update(int p_state, const Callable &p_callable) {
+	ERR_FAIL_INDEX(p_state, int(states.size()));
+	states[p_state].on_update = p_callable;
+	dirty = true;
+}
+
+void LimboHSMDefinition::set_guard(int p_state, const Callable &p_guard) {
+	ERR_FAIL_INDEX(p_state, int(states.size()));
+	states[p_state].guard = p_guard;
+}
+
+void LimboHSMDefinition::_compile() {
+	const int num_states = states.size();
+
+	event_ids.clear();
+	bool has_handlers = false;
+	for (const Transition &t : transitions) {
+		if (!event_ids.has(t.event)) {
+			event_ids.insert(t.event, event_ids.size());
+		}
+	}
+	for (const State &st : states) {
+		for (const KeyValue<StringName, Callable> &kv : st.handlers) {
+			has_handlers = true;
+			if (!event_ids.has(kv.key)) {
+				event_ids.insert(kv.key, event_ids.size());
+			}
+		}
+	}
+	num_events = event_ids.size();
+
+	transition_table.resize(num_states * num_events);
+	for (uint32_t i = 0; i < transition_table.size(); i++) {
+		transition_table[i] = -1;
+	}
+	anystate_table.resize((num_states + 1) * num_events);
+	for (uint32_t i = 0; i < anystate_table.size(); i++) {
+		anystate_table[i] = -1;
+	}
+	for (const Transition &t : transitions) {
+		int ev = event_ids[t.event];
+		if (t.from_state == ANYSTATE) {
+			anystate_table[(states[t.to_state].parent + 1) * num_events + ev] = t.to_state;
+		} else {
+			transition_table[t.from_state * num_events + ev] = t.to_state;
+		}
+	}
+
+	handler_table.clear();
+	if (has_handlers) {
+		handler_table.resize(num_states * num_events);
+		for (int i = 0; i < num_states; i++) {
+			for (const KeyValue<StringName, Callable> &kv : states[i].handlers) {
+				handler_table[i * num_events + event_ids[kv.key]] = kv.value;
+			}
+		}
+	}
+
+	paths.clear();
+	path_offsets.resize(num_states + 1);
+	has_update_callbacks = false;
+	for (int i = 0; i < num_states; i++) {
+		path_offsets[i] = paths.size();
+		int depth = 0;
+		for (int s = i; s != -1; s = states[s].parent) {
+			depth += 1;
+		}
+		paths.resize(paths.size() + depth);
+		int pos = paths.size() - 1;
+		for (int s = i; s != -1; s = states[s].parent) {
+			paths[pos--] = s;
+		}
+		has_update_callbacks = has_update_callbacks || states[i].on_update.is_valid();
+	}
+	path_offsets[num_states] = paths.size();
+
+	dirty = false;
+}
+
+void LimboHSMDefinition::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_state", "name", "parent"), &LimboHSMDefinition::add_state, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("get_state_count"), &LimboHSMDefinition::get_state_count);
+	ClassDB::bind_method(D_METHOD("get_state_name", "state"), &LimboHSMDefinition::get_state_name);
+	ClassDB::bind_method(D_METHOD("get_state_parent", "state"), &LimboHSMDefinition::get_state_parent);
+	ClassDB::bind_method(D_METHOD("find_state", "name"), &LimboHSMDefinition::find_state);
+	ClassDB::bind_method(D_METHOD("set_initial_state", "parent", "state"), &LimboHSMDefinition::set_initial_state);
+	ClassDB::bind_method(D_METHOD("get_initial_state", "parent"), &LimboHSMDefinition::get_initial_state);
+	ClassDB::bind_method(D_METHOD("add_transition", "from_state", "to_state", "event"), &LimboHSMDefinition::add_transition);
+	ClassDB::bind_method(D_METHOD("add_event_handler", "state", "event", "handler"), &LimboHSMDefinition::add_event_handler);
+	ClassDB::bind_method(D_METHOD("set_on_enter", "state", "callable"), &LimboHSMDefinition::set_on_enter);
+	ClassDB::bind_method(D_METHOD("set_on_exit", "state", "callable"), &LimboHSMDefinition::set_on_exit);
+	ClassDB::bind_method(D_METHOD("set_on_update", "state", "callable"), &LimboHSMDefinition::set_on_update);
+	ClassDB::bind_method(D_METHOD("set_guard", "state", "guard"), &LimboHSMDefinition::set_guard);
+
+	BIND_CONSTANT(ANYSTATE);
+}
@@ -0,0 +1,108 @@
+/**
+ * limbo_hsm_definition.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_HSM_DEFINITION_H
+#define LIMBO_HSM_DEFINITION_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+class LimboHSMBatch;
+
+// Lightweight state machine definition stepped by LimboHSMBatch.
+// States are identified by index; hierarchy is expressed by parent indices.
+// The definition is compiled into flat tables once and shared by all instances.
+class LimboHSMDefinition : public RefCounted {
+	GDCLASS(LimboHSMDefinition, RefCounted);
+
+public:
+	enum : int {
+		ANYSTATE = -1,
+	};
+
+private:
+	friend LimboHSMBatch;
+
+	struct State {
+		StringName name;
+		int parent = -1;
+		int initial_child = -1;
+		Callable on_enter;
+		Callable on_exit;
+		Callable on_update;
+		Callable guard;
+		HashMap<StringName, Callable> handlers;
+	};
+
+	struct Transition {
+		int from_state = ANYSTATE;
+		int to_state = -1;
+		StringName event;
+	};
+
+	LocalVector<State> states;
+	LocalVector<Transition> transitions;
+	int initial_state = -1;
+
+	// * Compiled data.
+	bool dirty = true;
+	HashMap<StringName, int> event_ids;
+	int num_events = 0;
+	LocalVector<int> transition_table; // [from_state * num_events + event] -> to_state
+	LocalVector<int> anystate_table; // [(parent + 1) * num_events + event] -> to_state
+	LocalVector<Callable> handler_table; // [state * num_events + event]
+	LocalVector<int> paths; // Flattened root-to-state chains.
+	LocalVector<uint32_t> path_offsets; // [state] -> start in paths; [state + 1] -> end.
+	bool has_update_callbacks = false;
+
+	void _compile();
+
+protected:
+	static void _bind_methods();
+
+public:
+	int add_state(const StringName &p_name, int p_parent = -1);
+	int get_state_count() const { return states.size(); }
+	StringName get_state_name(int p_state) const;
+	int get_state_parent(int p_state) const;
+	int find_state(const StringName &p_name) const;
+
+	void set_initial_state(int p_parent, int p_state);
+	int get_initial_state(int p_parent) const;
+
+	void add_transition(int p_from_state, int p_to_state, const StringName &p_event);
+	void add_event_handler(int p_state, const StringName &p_event, const Callable &p_handler);
+
+	void set_on_enter(int p_state, const Callable &p_callable);
+	void set_on_exit(int p_state, const Callable &p_callable);
+	void set_on_update(int p_state, const Callable &p_callable);
+	void set_guard(int p_state, const Callable &p_guard);
+
+	_FORCE_INLINE_ void compile() {
+		if (dirty) {
+			_compile();
+		}
+	}
+
+	LimboHSMDefinition() {}
+};
+
+#endif // LIMBO_HSM_DEFINITION_H
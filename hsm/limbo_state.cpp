@@ -12,6 +12,7 @@
 #include "limbo_state.h"
 
 #include "../util/limbo_compat.h"
+#include "limbo_hsm.h"
 
 #ifdef LIMBOAI_MODULE
 #endif // LIMBOAI_MODULE
@@ -77,7 +78,9 @@ void LimboState::_exit() {
 
 void LimboState::_update(double p_delta) {
 	VCALL_ARGS(_update, p_delta);
-	emit_signal(LimboStringNames::get_singleton()->updated, p_delta);
+	if (HAS_CONNECTIONS(this, LW_NAME(updated))) {
+		emit_signal(LW_NAME(updated), p_delta);
+	}
 }
 
 void LimboState::_setup() {
@@ -101,54 +104,82 @@ void LimboState::_initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard)
 	_setup();
 }
 
-bool LimboState::_dispatch(const StringName &p_event, const Variant &p_cargo) {
-	ERR_FAIL_COND_V(p_event == StringName(), false);
-	if (handlers.size() > 0 && handlers.has(p_event)) {
-		Variant ret;
+bool LimboState::_call_handler(const Callable &p_handler, const Variant &p_cargo) {
+	Variant ret;
 
 #ifdef LIMBOAI_MODULE
-		Callable::CallError ce;
-		if (p_cargo.get_type() == Variant::NIL) {
-			handlers[p_event].callp(nullptr, 0, ret, ce);
-			if (ce.error != Callable::CallError::CALL_OK) {
-				ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(handlers[p_event], nullptr, 0, ce));
-			}
-		} else {
-			const Variant *argptrs[1];
-			argptrs[0] = &p_cargo;
-			handlers[p_event].callp(argptrs, 1, ret, ce);
-			if (ce.error != Callable::CallError::CALL_OK) {
-				ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(handlers[p_event], argptrs, 1, ce));
-			}
+	Callable::CallError ce;
+	if (p_cargo.get_type() == Variant::NIL) {
+		p_handler.callp(nullptr, 0, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(p_handler, nullptr, 0, ce));
+		}
+	} else {
+		const Variant *argptrs[1];
+		argptrs[0] = &p_cargo;
+		p_handler.callp(argptrs, 1, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(p_handler, argptrs, 1, ce));
 		}
+	}
 
 #elif LIMBOAI_GDEXTENSION
-		if (p_cargo.get_type() == Variant::NIL) {
-			ret = handlers[p_event].call();
-		} else {
-			Array args;
-			args.append(p_cargo);
-			ret = handlers[p_event].callv(args);
-		}
+	if (p_cargo.get_type() == Variant::NIL) {
+		ret = p_handler.call();
+	} else {
+		Array args;
+		args.append(p_cargo);
+		ret = p_handler.callv(args);
+	}
 #endif // LIMBOAI_GDEXTENSION
 
-		if (unlikely(ret.get_type() != Variant::BOOL)) {
-			ERR_PRINT("Event handler returned unexpected type: " + Variant::get_type_name(ret.get_type()));
-		} else {
-			return ret;
+	if (unlikely(ret.get_type() != Variant::BOOL)) {
+		ERR_PRINT("Event handler returned unexpected type: " + Variant::get_type_name(ret.get_type()));
+		return false;
+	}
+	return ret;
+}
+
+bool LimboState::_dispatch(const StringName &p_event, const Variant &p_cargo) {
+	ERR_FAIL_COND_V(p_event == StringName(), false);
+	if (handlers.size() > 0) {
+		const Callable *handler = handlers.getptr(p_event);
+		if (handler) {
+			return _call_handler(*handler, p_cargo);
 		}
 	}
 	return false;
 }
 
+bool LimboState::_dispatch_compiled(int p_event_id, const StringName &p_event, const Variant &p_cargo) {
+	if (p_event_id >= 0 && p_event_id < int(handler_table.size()) && handler_table[p_event_id].is_valid()) {
+		return _call_handler(handler_table[p_event_id], p_cargo);
+	}
+	return false;
+}
+
 void LimboState::add_event_handler(const StringName &p_event, const Callable &p_handler) {
 	ERR_FAIL_COND(p_event == StringName());
 	ERR_FAIL_COND(!p_handler.is_valid());
 	handlers.insert(p_event, p_handler);
+	_invalidate_root_tables();
+}
+
+void LimboState::_invalidate_root_tables() {
+	LimboHSM *root = Object::cast_to<LimboHSM>(get_root());
+	if (root) {
+		root->tables_dirty = true;
+	}
 }
 
 bool LimboState::dispatch(const StringName &p_event, const Variant &p_cargo) {
-	return get_root()->_dispatch(p_event, p_cargo);
+	LimboState *root = get_root();
+	LimboHSM *root_hsm = Object::cast_to<LimboHSM>(root);
+	if (root_hsm && root_hsm->queue_events && root_hsm->is_active()) {
+		root_hsm->_enqueue_event(p_event, p_cargo);
+		return false;
+	}
+	return root->_dispatch(p_event, p_cargo);
 }
 
 LimboState *LimboState::call_on_enter(const Callable &p_callable) {
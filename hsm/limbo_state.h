@@ -15,15 +15,18 @@
 #include "../blackboard/blackboard.h"
 #include "../blackboard/blackboard_plan.h"
 
+#include "../util/limbo_binary_io.h"
 #include "../util/limbo_compat.h"
 #include "../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 class LimboHSM;
@@ -39,7 +42,13 @@ private:
 	HashMap<StringName, Callable> handlers;
 	Callable guard_callable;
 
+	// Compiled by the root LimboHSM: handlers indexed by event ID, and index of this state within its parent HSM.
+	LocalVector<Callable> handler_table;
+	int hsm_index = -1;
+
 	Ref<BlackboardPlan> _get_parent_scope_plan() const;
+	bool _call_handler(const Callable &p_handler, const Variant &p_cargo);
+	void _invalidate_root_tables();
 
 protected:
 	friend LimboHSM;
@@ -50,6 +59,7 @@ protected:
 
 	virtual void _initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard);
 	virtual bool _dispatch(const StringName &p_event, const Variant &p_cargo = Variant());
+	virtual bool _dispatch_compiled(int p_event_id, const StringName &p_event, const Variant &p_cargo);
 
 	virtual bool _should_use_new_scope() const { return blackboard_plan.is_valid() || is_root(); }
 	virtual void _update_blackboard_plan();
@@ -59,6 +69,12 @@ protected:
 	virtual void _exit();
 	virtual void _update(double p_delta);
 
+	// Runtime state of an active state for snapshots. See LimboHSM::save_state_to().
+	virtual void _save_state(LimboBinaryWriter &p_writer) const {}
+	virtual void _load_state(LimboBinaryReader &p_reader) {}
+	// Called instead of _exit() when loading a snapshot deactivates the state.
+	virtual void _reset_state() {}
+
 #ifdef LIMBOAI_MODULE
 	GDVIRTUAL0(_setup);
 	GDVIRTUAL0(_enter);
@@ -49,12 +49,15 @@
 #include "blackboard/blackboard.h"
 #include "blackboard/blackboard_plan.h"
 #include "bt/behavior_tree.h"
+#include "bt/bt_analyzer.h"
 #include "bt/bt_player.h"
+#include "bt/bt_simulator.h"
 #include "bt/bt_state.h"
 #include "bt/tasks/blackboard/bt_check_trigger.h"
 #include "bt/tasks/blackboard/bt_check_var.h"
 #include "bt/tasks/blackboard/bt_set_var.h"
 #include "bt/tasks/bt_action.h"
+#include "bt/tasks/bt_async_action.h"
 #include "bt/tasks/bt_comment.h"
 #include "bt/tasks/bt_composite.h"
 #include "bt/tasks/bt_condition.h"
@@ -68,6 +71,7 @@
 #include "bt/tasks/composites/bt_random_sequence.h"
 #include "bt/tasks/composites/bt_selector.h"
 #include "bt/tasks/composites/bt_sequence.h"
+#include "bt/tasks/decorators/bt_agent_view.h"
 #include "bt/tasks/decorators/bt_always_fail.h"
 #include "bt/tasks/decorators/bt_always_succeed.h"
 #include "bt/tasks/decorators/bt_cooldown.h"
@@ -102,6 +106,8 @@
 #include "editor/debugger/limbo_debugger_plugin.h"
 #include "editor/mode_switch_button.h"
 #include "hsm/limbo_hsm.h"
+#include "hsm/limbo_hsm_batch.h"
+#include "hsm/limbo_hsm_definition.h"
 #include "hsm/limbo_state.h"
 #include "util/limbo_string_names.h"
 #include "util/limbo_task_db.h"
@@ -144,12 +150,16 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 
 		GDREGISTER_CLASS(LimboState);
 		GDREGISTER_CLASS(LimboHSM);
+		GDREGISTER_CLASS(LimboHSMDefinition);
+		GDREGISTER_CLASS(LimboHSMBatch);
 
 		GDREGISTER_ABSTRACT_CLASS(BT);
 		GDREGISTER_ABSTRACT_CLASS(BTTask);
 		GDREGISTER_CLASS(BehaviorTree);
 		GDREGISTER_CLASS(BTPlayer);
 		GDREGISTER_CLASS(BTState);
+		GDREGISTER_CLASS(BTSimulator);
+		GDREGISTER_CLASS(BTAnalyzer);
 
 		LIMBO_REGISTER_TASK(BTComment);
 
@@ -177,9 +187,11 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		LIMBO_REGISTER_TASK(BTProbability);
 		LIMBO_REGISTER_TASK(BTForEach);
 		LIMBO_REGISTER_TASK(BTNewScope);
+		LIMBO_REGISTER_TASK(BTAgentView);
 		LIMBO_REGISTER_TASK(BTSubtree);
 
 		GDREGISTER_CLASS(BTAction);
+		GDREGISTER_CLASS(BTAsyncAction);
 		GDREGISTER_CLASS(BTCondition);
 		LIMBO_REGISTER_TASK(BTAwaitAnimation);
 		LIMBO_REGISTER_TASK(BTCallMethod);
@@ -277,6 +289,7 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 void uninitialize_limboai_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
 		LimboDebugger::deinitialize();
+		Blackboard::clear_shared_scopes();
 		LimboStringNames::free();
 		memdelete(_limbo_utility);
 	}
@@ -0,0 +1,188 @@
+/**
+ * limbo_benchmark.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_BENCHMARK_H
+#define LIMBO_BENCHMARK_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_parallel.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_succeed.h"
+#include "modules/limboai/bt/tasks/decorators/bt_subtree.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait_ticks.h"
+#include "modules/limboai/util/limboai_version.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+// Benchmarks are skipped in regular test runs. To run them:
+//   godot --test --tc="*[Benchmark]*" --no-skip
+// Set LIMBOAI_BENCHMARK_OUTPUT to a file path to write results as JSON.
+// Note: Memory statistics are only tracked by the engine in debug builds.
+
+namespace LimboBenchmark {
+
+struct Result {
+	String name;
+	int64_t iterations = 0;
+	double ns_per_op = 0.0;
+	double retained_bytes_per_op = 0.0;
+	int64_t peak_bytes = 0;
+};
+
+inline Vector<Result> &get_results() {
+	static Vector<Result> results;
+	return results;
+}
+
+inline void write_report() {
+	Array arr;
+	for (const Result &r : get_results()) {
+		Dictionary d;
+		d["name"] = r.name;
+		d["iterations"] = r.iterations;
+		d["ns_per_op"] = r.ns_per_op;
+		d["ops_per_sec"] = r.ns_per_op > 0.0 ? 1.0e9 / r.ns_per_op : 0.0;
+		d["retained_bytes_per_op"] = r.retained_bytes_per_op;
+		d["peak_bytes"] = r.peak_bytes;
+		arr.push_back(d);
+	}
+	Dictionary report;
+	report["limboai_version"] = GET_LIMBOAI_FULL_VERSION();
+	report["results"] = arr;
+	String json = JSON::stringify(report, "\t");
+
+	String path = OS::get_singleton()->get_environment("LIMBOAI_BENCHMARK_OUTPUT");
+	if (path.is_empty()) {
+		return;
+	}
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "LimboBenchmark: Failed to open output file: " + path);
+	f->store_string(json);
+}
+
+// Runs p_func p_iterations times (after a short warm-up) and records timing and memory stats.
+template <typename F>
+Result measure(const String &p_name, int p_iterations, F p_func) {
+	int warmup = MIN(MAX(p_iterations / 10, 1), 1000);
+	for (int i = 0; i < warmup; i++) {
+		p_func();
+	}
+
+	uint64_t mem_start = Memory::get_mem_usage();
+	uint64_t mem_peak = mem_start;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		p_func();
+		mem_peak = MAX(mem_peak, Memory::get_mem_usage());
+	}
+	uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start;
+	uint64_t mem_end = Memory::get_mem_usage();
+
+	Result r;
+	r.name = p_name;
+	r.iterations = p_iterations;
+	r.ns_per_op = double(elapsed_usec) * 1000.0 / double(p_iterations);
+	r.retained_bytes_per_op = double(int64_t(mem_end) - int64_t(mem_start)) / double(p_iterations);
+	r.peak_bytes = int64_t(mem_peak - mem_start);
+	get_results().push_back(r);
+
+	print_line(vformat("[Benchmark] %s: %.1f ns/op (%.0f ops/s), %.1f retained B/op, %d peak B (%d iterations)",
+			r.name, r.ns_per_op, r.ns_per_op > 0.0 ? 1.0e9 / r.ns_per_op : 0.0, r.retained_bytes_per_op, r.peak_bytes, r.iterations));
+	write_report();
+	return r;
+}
+
+// * Synthetic trees. Leaves are BTWaitTicks with zero ticks, so every tick traverses the whole tree.
+
+inline Ref<BTTask> make_leaf() {
+	Ref<BTWaitTicks> leaf = memnew(BTWaitTicks);
+	leaf->set_num_ticks(0);
+	return leaf;
+}
+
+inline Ref<BehaviorTree> make_wide_tree(int p_width) {
+	Ref<BTSequence> root = memnew(BTSequence);
+	for (int i = 0; i < p_width; i++) {
+		root->add_child(make_leaf());
+	}
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(root);
+	return bt;
+}
+
+inline Ref<BehaviorTree> make_deep_tree(int p_depth) {
+	Ref<BTTask> task = make_leaf();
+	for (int i = 0; i < p_depth; i++) {
+		Ref<BTAlwaysSucceed> dec = memnew(BTAlwaysSucceed);
+		dec->add_child(task);
+		task = dec;
+	}
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(task);
+	return bt;
+}
+
+inline Ref<BehaviorTree> make_subtree_heavy_tree(int p_num_subtrees, int p_subtree_width) {
+	Ref<BehaviorTree> inner = make_wide_tree(p_subtree_width);
+	Ref<BTSequence> root = memnew(BTSequence);
+	for (int i = 0; i < p_num_subtrees; i++) {
+		Ref<BTSubtree> st = memnew(BTSubtree);
+		st->set_subtree(inner);
+		root->add_child(st);
+	}
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(root);
+	return bt;
+}
+
+inline Ref<BehaviorTree> make_parallel_heavy_tree(int p_num_parallels, int p_width) {
+	Ref<BTParallel> root = memnew(BTParallel);
+	root->set_repeat(true);
+	root->set_num_successes_required(p_num_parallels + 1); // * Never finishes.
+	for (int i = 0; i < p_num_parallels; i++) {
+		Ref<BTParallel> par = memnew(BTParallel);
+		par->set_repeat(true);
+		par->set_num_successes_required(p_width + 1);
+		for (int j = 0; j < p_width; j++) {
+			par->add_child(make_leaf());
+		}
+		root->add_child(par);
+	}
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(root);
+	return bt;
+}
+
+// Creates a chain of p_depth nested scopes; the innermost scope is returned.
+// Each scope holds p_num_vars variables named "var_<scope>_<index>".
+inline Ref<Blackboard> make_scoped_blackboard(int p_num_vars, int p_depth) {
+	Ref<Blackboard> bb;
+	for (int s = 0; s < p_depth; s++) {
+		Ref<Blackboard> scope = memnew(Blackboard);
+		scope->set_parent(bb);
+		for (int i = 0; i < p_num_vars; i++) {
+			scope->set_var(vformat("var_%d_%d", s, i), i);
+		}
+		bb = scope;
+	}
+	return bb;
+}
+
+} //namespace LimboBenchmark
+
+#endif // LIMBO_BENCHMARK_H
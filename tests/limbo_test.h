@@ -27,11 +27,16 @@ public:
 
 	void callback() { num_callbacks += 1; }
 	void callback_delta(double delta) { num_callbacks += 1; }
+	bool callback_consume() {
+		num_callbacks += 1;
+		return true;
+	}
 
 protected:
 	static void _bind_methods() {
 		ClassDB::bind_method(D_METHOD("callback"), &CallbackCounter::callback);
 		ClassDB::bind_method(D_METHOD("callback_delta", "delta"), &CallbackCounter::callback_delta);
+		ClassDB::bind_method(D_METHOD("callback_consume"), &CallbackCounter::callback_consume);
 	}
 };
 
@@ -0,0 +1,100 @@
+/**
+ * test_agent_view.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_AGENT_VIEW_H
+#define TEST_AGENT_VIEW_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_set_var.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_agent_view.h"
+
+namespace TestAgentView {
+
+TEST_CASE("[Modules][LimboAI] BTAgentView") {
+	Node *agent = memnew(Node);
+	agent->set_process_priority(3);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("health", 100);
+
+	Ref<BTAgentView> view = memnew(BTAgentView);
+	PackedStringArray props;
+	props.push_back("process_priority");
+	view->set_properties(props);
+
+	Ref<BTSequence> seq = memnew(BTSequence);
+	view->add_child(seq);
+
+	Ref<BTCheckVar> check = memnew(BTCheckVar);
+	check->set_variable("process_priority");
+	Ref<BBVariant> expected = memnew(BBVariant);
+	expected->set_saved_value(3);
+	check->set_value(expected);
+	seq->add_child(check);
+
+	SUBCASE("Properties are readable as variables in a new scope") {
+		view->initialize(agent, bb, agent);
+		CHECK(view->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(view->get_blackboard() != bb);
+		CHECK(view->get_blackboard()->get_var("health", 0) == Variant(100));
+		CHECK_FALSE(bb->has_var("process_priority"));
+	}
+
+	SUBCASE("Changed variables are written back") {
+		Ref<BTSetVar> set = memnew(BTSetVar);
+		set->set_variable("process_priority");
+		Ref<BBVariant> new_value = memnew(BBVariant);
+		new_value->set_saved_value(7);
+		set->set_value(new_value);
+		seq->add_child(set);
+		view->initialize(agent, bb, agent);
+
+		CHECK(view->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(agent->get_process_priority() == 7);
+
+		// * Changes made to the agent outside the tree are picked up on the next tick.
+		agent->set_process_priority(3);
+		CHECK(view->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(agent->get_process_priority() == 7);
+	}
+
+	SUBCASE("Assigned variables are shadowed in the new scope") {
+		Ref<BTSetVar> set = memnew(BTSetVar);
+		set->set_variable("health");
+		Ref<BBVariant> new_value = memnew(BBVariant);
+		new_value->set_saved_value(50);
+		set->set_value(new_value);
+		seq->add_child(set);
+		view->initialize(agent, bb, agent);
+
+		CHECK(view->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(view->get_blackboard()->get_var("health", 0) == Variant(50));
+		CHECK(bb->get_var("health", 0) == Variant(100));
+	}
+
+	SUBCASE("When property doesn't exist") {
+		props.push_back("not_found");
+		view->set_properties(props);
+		view->initialize(agent, bb, agent);
+		CHECK(view->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_FALSE(view->get_blackboard()->has_var("not_found"));
+	}
+
+	memdelete(agent);
+}
+
+} //namespace TestAgentView
+
+#endif // TEST_AGENT_VIEW_H
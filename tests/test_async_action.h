@@ -0,0 +1,200 @@
+/**
+ * test_async_action.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_ASYNC_ACTION_H
+#define TEST_ASYNC_ACTION_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/tasks/bt_async_action.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+
+namespace TestAsyncAction {
+
+class BTTestAsyncAction : public BTAsyncAction {
+	GDCLASS(BTTestAsyncAction, BTAsyncAction);
+
+public:
+	Node *emitter = nullptr;
+	bool should_wait = true;
+	int num_steps = 0;
+	Variant received;
+
+protected:
+	static void _bind_methods() {}
+
+	virtual void _run() override {
+		num_steps = 1;
+		if (should_wait) {
+			suspend_for(0.05, 1);
+		}
+	}
+
+	virtual void _resume(int p_resume_point, const Array &p_signal_args) override {
+		num_steps += 1;
+		if (p_resume_point == 1) {
+			suspend_until(Signal(emitter, "ping"), 2);
+		} else if (p_resume_point == 2) {
+			received = p_signal_args.is_empty() ? Variant() : p_signal_args[0];
+			finish(SUCCESS);
+		}
+	}
+};
+
+// Waits like a script coroutine: the returned signal is what `await` connects to.
+class BTTestScriptAsyncAction : public BTAsyncAction {
+	GDCLASS(BTTestScriptAsyncAction, BTAsyncAction);
+
+public:
+	Node *emitter = nullptr;
+	int num_resumes = 0;
+	Array resumed_args;
+
+	void on_resumed(const Array &p_args) {
+		num_resumes += 1;
+		resumed_args = p_args;
+	}
+
+protected:
+	static void _bind_methods() {}
+
+	virtual void _run() override {
+		Signal resumed = wait_signal(Signal(emitter, "ping"));
+		resumed.connect(callable_mp(this, &BTTestScriptAsyncAction::on_resumed), CONNECT_ONE_SHOT);
+	}
+};
+
+struct ErrorCounter {
+	int num_errors = 0;
+	ErrorHandlerList handler;
+
+	static void _on_error(void *p_self, const char *p_func, const char *p_file, int p_line, const char *p_error, const char *p_message, bool p_editor_notify, ErrorHandlerType p_type) {
+		((ErrorCounter *)p_self)->num_errors += 1;
+	}
+
+	ErrorCounter() {
+		handler.errfunc = _on_error;
+		handler.userdata = this;
+		add_error_handler(&handler);
+	}
+	~ErrorCounter() { remove_error_handler(&handler); }
+};
+
+TEST_CASE("[Modules][LimboAI] BTAsyncAction") {
+	ClassDB::register_class<BTTestAsyncAction>();
+	ClassDB::register_class<BTTestScriptAsyncAction>();
+
+	Node *emitter = memnew(Node);
+	emitter->add_user_signal(MethodInfo("ping", PropertyInfo(Variant::INT, "value")));
+	Ref<BTTestAsyncAction> act = memnew(BTTestAsyncAction);
+	act->emitter = emitter;
+
+	SUBCASE("Finishes right away without waiting") {
+		act->should_wait = false;
+		CHECK(act->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(act->num_steps == 1);
+	}
+
+	SUBCASE("Resumes after waits") {
+		CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		CHECK(act->is_suspended());
+		CHECK(act->num_steps == 1);
+
+		// * Waiting for 0.05 seconds of tree time.
+		for (int i = 0; i < 3; i++) {
+			CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		}
+		CHECK(act->num_steps == 1);
+		CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		CHECK(act->num_steps == 2);
+
+		// * Waiting for signal.
+		CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		emitter->emit_signal("ping", 7);
+		CHECK(act->num_steps == 2); // * Resumed on the next tick.
+		CHECK(act->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(act->num_steps == 3);
+		CHECK(act->received == Variant(7));
+		CHECK_FALSE(act->is_suspended());
+	}
+
+	SUBCASE("Abort cancels the wait") {
+		for (int i = 0; i < 5; i++) {
+			act->execute(0.01666);
+		}
+		REQUIRE(act->num_steps == 2);
+		REQUIRE(emitter->is_connected("ping", Callable(act.ptr(), "_on_awaited_signal")));
+
+		act->abort();
+		CHECK_FALSE(act->is_suspended());
+		CHECK_FALSE(emitter->is_connected("ping", Callable(act.ptr(), "_on_awaited_signal")));
+
+		emitter->emit_signal("ping", 7);
+		CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		CHECK(act->num_steps == 1); // * Started over.
+	}
+
+	SUBCASE("When the awaited emitter is freed") {
+		Node *temp_emitter = memnew(Node);
+		temp_emitter->add_user_signal(MethodInfo("ping", PropertyInfo(Variant::INT, "value")));
+		act->emitter = temp_emitter;
+		for (int i = 0; i < 5; i++) {
+			act->execute(0.01666);
+		}
+		REQUIRE(act->num_steps == 2);
+		REQUIRE(act->is_suspended());
+		memdelete(temp_emitter);
+
+		ErrorCounter errors;
+		CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		act->abort();
+		CHECK_FALSE(act->is_suspended());
+		CHECK(errors.num_errors == 0);
+
+		act->emitter = emitter;
+		CHECK(act->execute(0.01666) == BTTask::RUNNING);
+		CHECK(act->num_steps == 1); // * Started over.
+		CHECK(errors.num_errors == 0);
+	}
+
+	SUBCASE("Resumes awaiting scripts") {
+		Ref<BTTestScriptAsyncAction> script_act = memnew(BTTestScriptAsyncAction);
+		script_act->emitter = emitter;
+		CHECK(script_act->execute(0.01666) == BTTask::RUNNING);
+		CHECK(script_act->is_suspended());
+
+		emitter->emit_signal("ping", 7);
+		CHECK(script_act->num_resumes == 0); // * Resumed on the next tick.
+		CHECK(script_act->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(script_act->num_resumes == 1);
+		REQUIRE(script_act->resumed_args.size() == 1);
+		CHECK(script_act->resumed_args[0] == Variant(7));
+		CHECK_FALSE(script_act->is_suspended());
+	}
+
+	SUBCASE("Abort drops awaiting scripts") {
+		Ref<BTTestScriptAsyncAction> script_act = memnew(BTTestScriptAsyncAction);
+		script_act->emitter = emitter;
+		CHECK(script_act->execute(0.01666) == BTTask::RUNNING);
+		script_act->abort();
+		CHECK_FALSE(script_act->is_connected("resumed", callable_mp(script_act.ptr(), &BTTestScriptAsyncAction::on_resumed)));
+
+		emitter->emit_signal("ping", 7);
+		CHECK(script_act->execute(0.01666) == BTTask::RUNNING); // * Started over.
+		CHECK(script_act->num_resumes == 0);
+	}
+
+	memdelete(emitter);
+}
+
+} //namespace TestAsyncAction
+
+#endif // TEST_ASYNC_ACTION_H
@@ -0,0 +1,514 @@
+/**
+ * test_benchmarks.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BENCHMARKS_H
+#define TEST_BENCHMARKS_H
+
+#include "limbo_benchmark.h"
+
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/blackboard/blackboard_plan.h"
+#include "modules/limboai/bt/bt_player.h"
+#include "modules/limboai/bt/bt_resume_cursor.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/editor/debugger/behavior_tree_data.h"
+#include "modules/limboai/hsm/limbo_hsm.h"
+#include "modules/limboai/hsm/limbo_hsm_batch.h"
+
+#ifdef TOOLS_ENABLED
+#include "modules/limboai/editor/task_tree.h"
+#include "modules/limboai/util/limbo_utility.h"
+#endif // TOOLS_ENABLED
+
+namespace TestBenchmarks {
+
+using namespace LimboBenchmark;
+
+static void _benchmark_tree(const String &p_name, const Ref<BehaviorTree> &p_bt, int p_iterations) {
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	measure(p_name + "/instantiate", p_iterations / 10, [&]() {
+		Ref<BTTask> inst = p_bt->instantiate(agent, bb, agent);
+	});
+
+	Ref<BTTask> inst = p_bt->instantiate(agent, bb, agent);
+	REQUIRE(inst.is_valid());
+
+	measure(p_name + "/execute", p_iterations, [&]() {
+		inst->execute(0.01666);
+	});
+
+	measure(p_name + "/clone", p_iterations / 10, [&]() {
+		Ref<BTTask> cl = inst->clone();
+	});
+
+	measure(p_name + "/serialize", p_iterations / 10, [&]() {
+		Array arr = BehaviorTreeData::serialize(inst, NodePath("Agent/BTPlayer"), "res://bench.tres");
+	});
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Tree execution" * doctest::skip()) {
+	_benchmark_tree("wide_100", make_wide_tree(100), 20000);
+	_benchmark_tree("deep_100", make_deep_tree(100), 20000);
+	_benchmark_tree("subtree_heavy_20x10", make_subtree_heavy_tree(20, 10), 20000);
+	_benchmark_tree("parallel_heavy_10x10", make_parallel_heavy_tree(10, 10), 20000);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Resuming running path" * doctest::skip()) {
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	for (int depth : { 10, 20, 30 }) {
+		// * Chain of sequences and decorators with a running leaf at the bottom.
+		Ref<BTTask> task = memnew(BTTestAction(BTTask::RUNNING));
+		for (int i = 0; i < depth; i++) {
+			Ref<BTTask> parent = (i % 2) ? Ref<BTTask>(memnew(BTAlwaysSucceed)) : Ref<BTTask>(memnew(BTSequence));
+			parent->add_child(task);
+			task = parent;
+		}
+		task->initialize(agent, bb, agent);
+
+		measure(vformat("resume_cursor/depth_%d_from_root", depth), 1000000, [&]() {
+			task->execute(0.01666);
+		});
+
+		BTResumeCursor cursor;
+		measure(vformat("resume_cursor/depth_%d_resumed", depth), 1000000, [&]() {
+			cursor.execute(task, 0.01666);
+		});
+	}
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] BTPlayer update overhead" * doctest::skip()) {
+	Ref<CallbackCounter> listener = memnew(CallbackCounter);
+	Node *agent = memnew(Node);
+	BTPlayer *player = memnew(BTPlayer);
+	agent->add_child(player);
+	player->set_owner(agent);
+	player->set_update_mode(BTPlayer::MANUAL);
+	player->set_blackboard(memnew(Blackboard));
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(make_leaf());
+	player->set_behavior_tree(bt);
+	REQUIRE(player->get_tree_instance().is_valid());
+
+	// * Per-tick cost of BTPlayer on a single-leaf tree, without and with a listener.
+	measure("bt_player/update_no_listeners", 1000000, [&]() {
+		player->update(0.01666);
+	});
+
+	player->connect(LW_NAME(updated), callable_mp(listener.ptr(), &CallbackCounter::callback_delta));
+	measure("bt_player/update_with_listener", 1000000, [&]() {
+		player->update(0.01666);
+	});
+
+	memdelete(agent);
+}
+
+// Selector with p_num_guarded branches guarded by failing conditions, followed by a running fallback branch.
+static Ref<BTTask> _make_guarded_selector(Ref<BTComposite> p_selector, int p_num_guarded, BTCondition::ObserverAborts p_aborts) {
+	for (int i = 0; i < p_num_guarded; i++) {
+		Ref<BTCheckVar> check = memnew(BTCheckVar);
+		check->set_variable(vformat("var_0_%d", i));
+		Ref<BBVariant> value = memnew(BBVariant);
+		value->set_saved_value(-1);
+		check->set_value(value);
+		check->set_observer_aborts(p_aborts);
+		Ref<BTSequence> branch = memnew(BTSequence);
+		branch->add_child(check);
+		branch->add_child(make_leaf());
+		p_selector->add_child(branch);
+	}
+	p_selector->add_child(memnew(BTTestAction(BTTask::RUNNING)));
+	return p_selector;
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Observer aborts" * doctest::skip()) {
+	const int num_guarded = 20;
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = make_scoped_blackboard(num_guarded, 1);
+
+	// * Dynamic selector re-evaluates every guard on each tick.
+	Ref<BTTask> dynamic = _make_guarded_selector(memnew(BTDynamicSelector), num_guarded, BTCondition::OBSERVER_ABORTS_NONE);
+	dynamic->initialize(agent, bb, agent);
+	measure("observer_aborts/dynamic_selector_20_guards", 100000, [&]() {
+		dynamic->execute(0.01666);
+	});
+
+	// * Observing selector only re-evaluates guards whose variables were written to.
+	Ref<BTTask> observing = _make_guarded_selector(memnew(BTSelector), num_guarded, BTCondition::OBSERVER_ABORTS_LOWER_PRIORITY);
+	observing->initialize(agent, bb, agent);
+	measure("observer_aborts/observing_selector_20_guards", 100000, [&]() {
+		observing->execute(0.01666);
+	});
+
+	StringName changing_var = vformat("var_0_%d", num_guarded / 2);
+	measure("observer_aborts/observing_selector_20_guards_1_change", 100000, [&]() {
+		bb->set_var(changing_var, 0);
+		observing->execute(0.01666);
+	});
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Blackboard access" * doctest::skip()) {
+	const int num_vars = 100;
+	const int depth = 4;
+	Ref<Blackboard> bb = make_scoped_blackboard(num_vars, depth);
+
+	StringName local_var = vformat("var_%d_%d", depth - 1, num_vars / 2);
+	StringName outer_var = vformat("var_%d_%d", 0, num_vars / 2);
+	StringName missing_var = "missing_var";
+	REQUIRE(bb->has_var(local_var));
+	REQUIRE(bb->has_var(outer_var));
+
+	measure("blackboard/get_var_local", 1000000, [&]() {
+		Variant v = bb->get_var(local_var, Variant(), false);
+	});
+
+	measure("blackboard/get_var_outer_scope", 1000000, [&]() {
+		Variant v = bb->get_var(outer_var, Variant(), false);
+	});
+
+	measure("blackboard/get_var_missing", 1000000, [&]() {
+		Variant v = bb->get_var(missing_var, Variant(), false);
+	});
+
+	measure("blackboard/set_var_local", 1000000, [&]() {
+		bb->set_var(local_var, 42);
+	});
+
+	// * Same accesses through interned IDs, as used by built-in tasks.
+	uint32_t local_id = bb->intern_var(local_var);
+	uint32_t outer_id = bb->intern_var(outer_var);
+	uint32_t missing_id = bb->intern_var(missing_var);
+
+	measure("blackboard/get_var_by_id_local", 1000000, [&]() {
+		Variant v = bb->get_var_by_id(local_id, Variant(), false);
+	});
+
+	measure("blackboard/get_var_by_id_outer_scope", 1000000, [&]() {
+		Variant v = bb->get_var_by_id(outer_id, Variant(), false);
+	});
+
+	measure("blackboard/get_var_by_id_missing", 1000000, [&]() {
+		Variant v = bb->get_var_by_id(missing_id, Variant(), false);
+	});
+
+	measure("blackboard/set_var_by_id_local", 1000000, [&]() {
+		bb->set_var_by_id(local_id, 42);
+	});
+
+	// * 50 agents reading a squad scope.
+	Ref<Blackboard> squad = Blackboard::get_shared_scope("benchmark_squad");
+	Array targets;
+	targets.resize(500);
+	squad->set_var("targets", targets);
+	Vector<Ref<Blackboard>> agents;
+	for (int i = 0; i < 50; i++) {
+		Ref<Blackboard> agent_bb = make_scoped_blackboard(num_vars, 1);
+		agent_bb->set_parent(squad);
+		agents.push_back(agent_bb);
+	}
+	StringName targets_var = "targets";
+	measure("blackboard/get_var_shared_scope_50_agents", 100000, [&]() {
+		for (const Ref<Blackboard> &agent_bb : agents) {
+			Variant v = agent_bb->get_var(targets_var, Variant(), false);
+		}
+	});
+	Blackboard::remove_shared_scope("benchmark_squad");
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Blackboard bulk export" * doctest::skip()) {
+	for (int num_vars : { 10, 50, 100, 500 }) {
+		Ref<Blackboard> bb = make_scoped_blackboard(num_vars, 1);
+		Ref<Blackboard> target = memnew(Blackboard);
+		int iterations = 1000000 / num_vars;
+
+		measure(vformat("blackboard_bulk/%d/dict_export", num_vars), iterations, [&]() {
+			Dictionary d = bb->get_vars_as_dict();
+		});
+		Dictionary dict = bb->get_vars_as_dict();
+		measure(vformat("blackboard_bulk/%d/dict_import", num_vars), iterations, [&]() {
+			target->populate_from_dict(dict);
+		});
+
+		measure(vformat("blackboard_bulk/%d/packed_export", num_vars), iterations, [&]() {
+			PackedByteArray data = bb->export_vars();
+		});
+		PackedByteArray packed = bb->export_vars();
+		measure(vformat("blackboard_bulk/%d/packed_import", num_vars), iterations, [&]() {
+			target->import_vars(packed);
+		});
+
+		// * Every tenth variable changes between snapshots.
+		for (int i = 0; i < num_vars; i += 10) {
+			bb->set_var(vformat("var_0_%d", i), -i);
+		}
+		measure(vformat("blackboard_bulk/%d/delta_export", num_vars), iterations, [&]() {
+			PackedByteArray data = bb->export_vars_delta(packed);
+		});
+		PackedByteArray delta = bb->export_vars_delta(packed);
+		measure(vformat("blackboard_bulk/%d/delta_import", num_vars), iterations, [&]() {
+			target->import_vars(delta);
+		});
+		print_line(vformat("[Benchmark] blackboard_bulk/%d: full %d B, delta %d B", num_vars, packed.size(), delta.size()));
+	}
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Blackboard spawn" * doctest::skip()) {
+	Node *agent = memnew(Node);
+	for (int i = 0; i < 10; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		agent->add_child(child);
+	}
+	Ref<Blackboard> parent_scope = memnew(Blackboard);
+
+	for (int num_vars : { 10, 50, 100 }) {
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		for (int i = 0; i < num_vars; i++) {
+			if (i % 10 == 0) {
+				BBVariable var(Variant::NODE_PATH);
+				var.set_value(NodePath(vformat("Child%d", i / 10 % 10)));
+				plan->add_var(vformat("node_%d", i), var);
+			} else {
+				BBVariable var(Variant::INT);
+				var.set_value(i);
+				plan->add_var(vformat("var_%d", i), var);
+			}
+		}
+		int iterations = 1000000 / num_vars;
+
+		// * Spawning an agent: a fresh blackboard populated from the plan.
+		measure(vformat("blackboard_spawn/%d/create_blackboard", num_vars), iterations, [&]() {
+			Ref<Blackboard> bb = plan->create_blackboard(agent, parent_scope);
+		});
+
+		// * Repopulating an existing blackboard, as BTPlayer does on ready.
+		Ref<Blackboard> bb = plan->create_blackboard(agent, parent_scope);
+		measure(vformat("blackboard_spawn/%d/populate_no_overwrite", num_vars), iterations, [&]() {
+			plan->populate_blackboard(bb, false, agent);
+		});
+	}
+
+	memdelete(agent);
+}
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][LimboAI][Benchmark] TaskTree editing" * doctest::skip()) {
+	// * 1 + 100 + 100 * 49 = 5001 tasks.
+	Ref<BehaviorTree> bt = make_parallel_heavy_tree(100, 49);
+	TaskTree *task_tree = memnew(TaskTree);
+
+	measure("task_tree/5000/load", 10, [&]() {
+		task_tree->load_bt(bt);
+	});
+
+	measure("task_tree/5000/update_unchanged", 100, [&]() {
+		task_tree->update_tree();
+	});
+
+	// * Adding and removing a leaf, as the editor does with undo/redo.
+	Ref<BTTask> branch = bt->get_root_task()->get_child(50);
+	Ref<BTTask> leaf = make_leaf();
+	measure("task_tree/5000/update_add_remove_leaf", 100, [&]() {
+		branch->add_child_at_index(leaf, 10);
+		task_tree->update_tree();
+		branch->remove_child(leaf);
+		task_tree->update_tree();
+	});
+
+	// * Moving a branch to the front of the root.
+	Ref<BTTask> root = bt->get_root_task();
+	measure("task_tree/5000/update_move_branch", 100, [&]() {
+		Ref<BTTask> last = root->get_child(root->get_child_count() - 1);
+		root->remove_child(last);
+		root->add_child_at_index(last, 0);
+		task_tree->update_tree();
+	});
+
+	// * With every branch collapsed, only the children of the root get items.
+	for (int i = 0; i < root->get_child_count(); i++) {
+		root->get_child(i)->set_display_collapsed(true);
+	}
+	measure("task_tree/5000/load_collapsed", 10, [&]() {
+		task_tree->load_bt(bt);
+	});
+
+	task_tree->unload();
+	memdelete(task_tree);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Opening a tree in TaskTree" * doctest::skip()) {
+	// * 1 + 40 + 40 * 49 = 2001 tasks.
+	Ref<BehaviorTree> bt = make_parallel_heavy_tree(40, 49);
+	TaskTree *task_tree = memnew(TaskTree);
+
+	// * As on the first open, or after scripts were reloaded.
+	measure("task_tree/2000/open_cold", 10, [&]() {
+		LimboUtility::get_singleton()->clear_task_icon_cache();
+		LimboUtility::get_singleton()->clear_task_name_cache();
+		task_tree->load_bt(bt);
+	});
+
+	// * As when switching back to a tab.
+	measure("task_tree/2000/open_warm", 10, [&]() {
+		task_tree->load_bt(bt);
+	});
+
+	task_tree->unload();
+	memdelete(task_tree);
+}
+#endif // TOOLS_ENABLED
+
+// Builds a 3-level HSM with 30 states: 3 regions, each with 3 nested HSMs holding 2 leaf states.
+static LimboHSM *_make_hsm() {
+	LimboHSM *root = memnew(LimboHSM);
+	root->set_update_mode(LimboHSM::MANUAL);
+	for (int i = 0; i < 3; i++) {
+		LimboHSM *region = memnew(LimboHSM);
+		root->add_child(region);
+		root->add_transition(root->anystate(), region, vformat("region_%d", i));
+		for (int j = 0; j < 3; j++) {
+			LimboHSM *group = memnew(LimboHSM);
+			region->add_child(group);
+			region->add_transition(region->anystate(), group, vformat("group_%d", j));
+			LimboState *leaf_a = memnew(LimboState);
+			LimboState *leaf_b = memnew(LimboState);
+			group->add_child(leaf_a);
+			group->add_child(leaf_b);
+			group->add_transition(leaf_a, leaf_b, "toggle");
+			group->add_transition(leaf_b, leaf_a, "toggle");
+		}
+	}
+	return root;
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] HSM dispatch" * doctest::skip()) {
+	Node *agent = memnew(Node);
+	LimboHSM *hsm = _make_hsm();
+	hsm->initialize(agent);
+	hsm->set_active(true);
+	REQUIRE(hsm->get_leaf_state() != nullptr);
+
+	StringName toggle = "toggle";
+	StringName unknown = "unknown_event";
+	StringName regions[2] = { "region_1", "region_2" };
+	int n = 0;
+
+	// * Handled by the innermost HSM.
+	measure("hsm/dispatch_leaf_transition", 1000000, [&]() {
+		hsm->get_leaf_state()->dispatch(toggle);
+	});
+
+	// * Bubbles up to the root and switches regions.
+	measure("hsm/dispatch_root_transition", 100000, [&]() {
+		hsm->get_leaf_state()->dispatch(regions[n++ & 1]);
+	});
+
+	// * Not handled anywhere.
+	measure("hsm/dispatch_unhandled", 1000000, [&]() {
+		hsm->get_leaf_state()->dispatch(unknown);
+	});
+
+	memdelete(hsm);
+	memdelete(agent);
+}
+
+class BenchmarkCounter : public RefCounted {
+	GDCLASS(BenchmarkCounter, RefCounted);
+
+public:
+	int64_t num_calls = 0;
+
+	void node_update(double p_delta) { num_calls += 1; }
+	void batch_update(const Variant &p_agent, int p_instance, double p_delta) { num_calls += 1; }
+};
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Bulk HSM stepping" * doctest::skip()) {
+	const int num_agents = 10000;
+	Ref<BenchmarkCounter> counter = memnew(BenchmarkCounter);
+	Node *agent = memnew(Node);
+
+	// * Node-based: one LimboHSM with two states per agent.
+	LocalVector<LimboHSM *> hsms;
+	for (int i = 0; i < num_agents; i++) {
+		LimboHSM *hsm = memnew(LimboHSM);
+		hsm->set_update_mode(LimboHSM::MANUAL);
+		LimboState *a = memnew(LimboState);
+		LimboState *b = memnew(LimboState);
+		a->call_on_update(callable_mp(counter.ptr(), &BenchmarkCounter::node_update));
+		b->call_on_update(callable_mp(counter.ptr(), &BenchmarkCounter::node_update));
+		hsm->add_child(a);
+		hsm->add_child(b);
+		hsm->add_transition(a, b, "toggle");
+		hsm->add_transition(b, a, "toggle");
+		hsm->initialize(agent);
+		hsm->set_active(true);
+		hsms.push_back(hsm);
+	}
+
+	StringName toggle = "toggle";
+	measure("hsm_bulk/nodes_10k_update", 100, [&]() {
+		for (LimboHSM *hsm : hsms) {
+			hsm->update(0.01666);
+		}
+	});
+	measure("hsm_bulk/nodes_10k_dispatch_update", 100, [&]() {
+		for (LimboHSM *hsm : hsms) {
+			hsm->dispatch(toggle);
+			hsm->update(0.01666);
+		}
+	});
+
+	for (LimboHSM *hsm : hsms) {
+		memdelete(hsm);
+	}
+
+	// * Data-oriented: the same machine compiled once, 10k compact instances.
+	Ref<LimboHSMDefinition> def = memnew(LimboHSMDefinition);
+	int a = def->add_state("A");
+	int b = def->add_state("B");
+	def->add_transition(a, b, toggle);
+	def->add_transition(b, a, toggle);
+	def->set_on_update(a, callable_mp(counter.ptr(), &BenchmarkCounter::batch_update));
+	def->set_on_update(b, callable_mp(counter.ptr(), &BenchmarkCounter::batch_update));
+
+	LimboHSMBatch *batch = memnew(LimboHSMBatch);
+	batch->set_update_mode(LimboHSMBatch::MANUAL);
+	batch->set_definition(def);
+	for (int i = 0; i < num_agents; i++) {
+		batch->add_instance(agent);
+	}
+
+	measure("hsm_bulk/batch_10k_update", 100, [&]() {
+		batch->update(0.01666);
+	});
+	measure("hsm_bulk/batch_10k_dispatch_update", 100, [&]() {
+		batch->dispatch_all(toggle);
+		batch->update(0.01666);
+	});
+
+	memdelete(batch);
+	memdelete(agent);
+}
+
+} //namespace TestBenchmarks
+
+#endif // TEST_BENCHMARKS_H
@@ -5,6 +5,7 @@
 #include "limbo_test.h"
 
 #include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/blackboard/blackboard_plan.h"
 
 namespace TestBlackboard {
 
@@ -179,6 +180,226 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(333));
 		CHECK_EQ(target_blackboard->get_var("aa", not_found), Variant(333));
 	}
+
+	SUBCASE("Test outer scope lookups after scope changes") {
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		Ref<Blackboard> grand_parent_scope = memnew(Blackboard);
+		blackboard->set_parent(parent_scope);
+		parent_scope->set_parent(grand_parent_scope);
+
+		CHECK_FALSE(blackboard->has_var("x"));
+		grand_parent_scope->set_var("x", 1);
+		CHECK_EQ(blackboard->get_var("x", not_found), Variant(1));
+		parent_scope->set_var("x", 2); // * shadows the grand parent's "x"
+		CHECK_EQ(blackboard->get_var("x", not_found), Variant(2));
+		parent_scope->set_var("x", 3);
+		CHECK_EQ(blackboard->get_var("x", not_found), Variant(3));
+		parent_scope->erase_var("x");
+		CHECK_EQ(blackboard->get_var("x", not_found), Variant(1));
+		parent_scope->set_parent(nullptr);
+		CHECK_FALSE(blackboard->has_var("x"));
+	}
+
+	SUBCASE("Test interned variable IDs") {
+		uint32_t a_id = blackboard->intern_var("a");
+		uint32_t x_id = blackboard->intern_var("x");
+		CHECK_EQ(blackboard->intern_var("a"), a_id);
+		CHECK_NE(a_id, x_id);
+		CHECK_EQ(blackboard->get_interned_name(x_id), StringName("x"));
+
+		CHECK_EQ(blackboard->get_var_by_id(a_id, not_found), Variant(1));
+		blackboard->set_var_by_id(a_id, 10);
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(10));
+
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		blackboard->set_parent(parent_scope);
+		CHECK_FALSE(blackboard->has_var_by_id(x_id));
+		parent_scope->set_var("x", 1);
+		CHECK_EQ(blackboard->get_var_by_id(x_id, not_found), Variant(1));
+		blackboard->set_var_by_id(x_id, 2); // * creates a local variable, like set_var()
+		CHECK_EQ(blackboard->get_var_by_id(x_id, not_found), Variant(2));
+		CHECK_EQ(parent_scope->get_var("x", not_found), Variant(1));
+		blackboard->erase_var("x");
+		CHECK_EQ(blackboard->get_var_by_id(x_id, not_found), Variant(1));
+
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_var_by_id(1000, not_found), not_found);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Test shared scopes") {
+		CHECK_FALSE(Blackboard::has_shared_scope("squad"));
+		Ref<Blackboard> squad = Blackboard::get_shared_scope("squad");
+		CHECK(squad->is_shared());
+		CHECK(Blackboard::has_shared_scope("squad"));
+		CHECK_EQ(Blackboard::get_shared_scope("squad"), squad);
+
+		Array targets;
+		targets.push_back(1);
+		squad->set_var("targets", targets);
+		targets.push_back(2); // * the shared value is a copy
+		blackboard->set_parent(squad);
+		Array seen = blackboard->get_var("targets", not_found);
+		CHECK(seen.is_read_only());
+		CHECK_EQ(seen.size(), 1);
+
+		Array frozen = seen;
+		squad->set_var("targets", frozen); // * already read-only, not copied again
+		CHECK(Array(squad->get_var("targets", not_found)).id() == seen.id());
+
+		Dictionary orders;
+		orders["waypoints"] = targets;
+		squad->set_var("orders", orders);
+		Dictionary seen_orders = blackboard->get_var("orders", not_found);
+		CHECK(seen_orders.is_read_only());
+		CHECK(Array(seen_orders["waypoints"]).is_read_only()); // * nested values are frozen too
+
+		Blackboard::remove_shared_scope("squad");
+		CHECK_FALSE(Blackboard::has_shared_scope("squad"));
+		CHECK(blackboard->has_var("targets")); // * still referenced as a parent
+	}
+
+	SUBCASE("Test lookup caches across unrelated scopes") {
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		parent_scope->set_var("e", 5);
+		blackboard->set_parent(parent_scope);
+		uint32_t id = blackboard->intern_var("e");
+		CHECK_EQ(blackboard->get_var_by_id(id, not_found), Variant(5));
+		uint64_t stamp = blackboard->get_var_stamp_by_id(id);
+
+		// * Creating variables on unrelated blackboards doesn't invalidate this scope chain.
+		Ref<Blackboard> other = memnew(Blackboard);
+		other->set_var("unrelated", 1);
+		CHECK_EQ(blackboard->get_var_stamp_by_id(id), stamp);
+
+		// * Changes in outer scopes do.
+		parent_scope->set_var("f", 6);
+		CHECK_NE(blackboard->get_var_stamp_by_id(id), stamp);
+		CHECK_EQ(blackboard->get_var("f", not_found), Variant(6));
+		Ref<Blackboard> shadowing = memnew(Blackboard);
+		shadowing->set_var("e", 7);
+		parent_scope->set_parent(shadowing);
+		CHECK_EQ(blackboard->get_var_by_id(id, not_found), Variant(5)); // * closer scope wins
+		parent_scope->erase_var("e");
+		CHECK_EQ(blackboard->get_var_by_id(id, not_found), Variant(7));
+	}
+
+	SUBCASE("Test export_vars() and import_vars()") {
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		parent_scope->set_var("a", 5);
+		parent_scope->set_var("d", 4);
+		blackboard->set_parent(parent_scope);
+
+		Ref<Blackboard> copy = memnew(Blackboard);
+		CHECK(copy->import_vars(blackboard->export_vars()) == OK);
+		CHECK_EQ(copy->get_vars_as_dict(), blackboard->get_vars_as_dict());
+
+		copy->clear();
+		CHECK(copy->import_vars(blackboard->export_vars(true)) == OK);
+		CHECK_EQ(copy->get_var("a", not_found), Variant(1)); // * parent value is shadowed
+		CHECK_EQ(copy->get_var("d", not_found), Variant(4));
+
+		Ref<TestPropertyHolder> holder = memnew(TestPropertyHolder);
+		blackboard->bind_var_to_property("a", holder.ptr(), "property");
+		copy->clear();
+		CHECK(copy->import_vars(blackboard->export_vars(false, true)) == OK);
+		CHECK_FALSE(copy->has_var("a"));
+		CHECK(copy->has_var("b"));
+
+		ERR_PRINT_OFF;
+		CHECK(copy->import_vars(PackedByteArray()) == ERR_FILE_UNRECOGNIZED);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Test export_vars_delta()") {
+		PackedByteArray base = blackboard->export_vars();
+		Ref<Blackboard> copy = memnew(Blackboard);
+		REQUIRE(copy->import_vars(base) == OK);
+
+		PackedByteArray empty_delta = blackboard->export_vars_delta(base);
+		blackboard->set_var("b", Vector2(3, 3));
+		blackboard->set_var("e", 42);
+		blackboard->erase_var("c");
+		PackedByteArray delta = blackboard->export_vars_delta(base);
+		CHECK(delta.size() > empty_delta.size());
+		CHECK(delta.size() < blackboard->export_vars().size()); // * "a" is unchanged
+
+		CHECK(copy->import_vars(delta) == OK);
+		CHECK_EQ(copy->get_vars_as_dict(), blackboard->get_vars_as_dict());
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] Test BlackboardPlan") {
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	plan->add_var("health", BBVariable(Variant::INT));
+	plan->get_var("health").set_value(100);
+	plan->add_var("speed", BBVariable(Variant::FLOAT));
+	plan->add_var("child", BBVariable(Variant::NODE_PATH));
+	plan->get_var("child").set_value(NodePath("Child"));
+
+	Node *agent = memnew(Node);
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	agent->add_child(child);
+
+	SUBCASE("Test create_blackboard()") {
+		Ref<Blackboard> bb = plan->create_blackboard(agent);
+		CHECK_EQ(bb->get_var("health"), Variant(100));
+		CHECK_EQ(bb->get_var("speed"), Variant(0.0));
+		CHECK_EQ(bb->get_var("child"), Variant(child)); // * prefetched
+
+		// * Variables are not shared between blackboards.
+		bb->set_var("health", 5);
+		CHECK_EQ(plan->create_blackboard(agent)->get_var("health"), Variant(100));
+	}
+
+	SUBCASE("Test populate_blackboard() without overwriting") {
+		Ref<Blackboard> parent = memnew(Blackboard);
+		parent->set_var("speed", 2.0);
+		Ref<Blackboard> bb = memnew(Blackboard);
+		bb->set_parent(parent);
+		bb->set_var("health", 10);
+		plan->populate_blackboard(bb, false, agent);
+		CHECK_EQ(bb->get_var("health"), Variant(10));
+		CHECK_FALSE(bb->list_vars().has("speed")); // * already defined in the parent scope
+		CHECK(bb->has_var("child"));
+	}
+
+	SUBCASE("Test plan changes after first use") {
+		plan->create_blackboard(agent);
+		plan->get_var("health").set_value(50);
+		plan->add_var("ammo", BBVariable(Variant::INT));
+		plan->rename_var("speed", "velocity");
+		Ref<Blackboard> bb = plan->create_blackboard(agent);
+		CHECK_EQ(bb->get_var("health"), Variant(50));
+		CHECK(bb->has_var("ammo"));
+		CHECK(bb->has_var("velocity"));
+		CHECK_FALSE(bb->has_var("speed"));
+	}
+
+	SUBCASE("Test sync with base plan") {
+		Ref<BlackboardPlan> derived = memnew(BlackboardPlan);
+		derived->set_base_plan(plan);
+		REQUIRE(derived->get_var_count() == 3);
+		derived->get_var("health").set_value(5); // * overridden in derived plan
+
+		Ref<CallbackCounter> changes = memnew(CallbackCounter);
+		derived->connect(LW_NAME(changed), callable_mp(changes.ptr(), &CallbackCounter::callback));
+
+		plan->rename_var("health", "hp");
+		plan->remove_var("speed");
+		plan->add_var("ammo", BBVariable(Variant::INT));
+		plan->move_var(2, 0);
+		derived->sync_with_base_plan();
+		CHECK(changes->num_callbacks == 1); // * single notification per sync
+		CHECK_EQ(derived->list_vars(), plan->list_vars());
+		CHECK_EQ(derived->get_var("hp").get_value(), Variant(5)); // * override survives renaming
+
+		derived->sync_with_base_plan();
+		CHECK(changes->num_callbacks == 1); // * nothing changed
+	}
+
+	memdelete(agent);
 }
 
 } //namespace TestBlackboard
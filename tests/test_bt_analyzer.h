@@ -0,0 +1,117 @@
+/**
+ * test_bt_analyzer.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_ANALYZER_H
+#define TEST_BT_ANALYZER_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/blackboard_plan.h"
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_analyzer.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_set_var.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_fail.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_succeed.h"
+#include "modules/limboai/bt/tasks/decorators/bt_probability.h"
+#include "modules/limboai/bt/tasks/decorators/bt_subtree.h"
+#include "modules/limboai/bt/tasks/utility/bt_evaluate_expression.h"
+
+namespace TestBTAnalyzer {
+
+TEST_CASE("[Modules][LimboAI] BTAnalyzer") {
+	ClassDB::register_class<BTTestAction>();
+
+	Ref<BehaviorTree> sub = memnew(BehaviorTree);
+	sub->set_blackboard_plan(memnew(BlackboardPlan));
+	sub->set_root_task(memnew(BTEvaluateExpression));
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	plan->add_var("health", BBVariable(Variant::INT));
+	plan->add_var("speed", BBVariable(Variant::FLOAT));
+	bt->set_blackboard_plan(plan);
+
+	Ref<BTSequence> root = memnew(BTSequence);
+	bt->set_root_task(root);
+
+	Ref<BTSelector> sel = memnew(BTSelector);
+	sel->add_child(memnew(BTAlwaysSucceed));
+	sel->add_child(memnew(BTTestAction));
+	root->add_child(sel);
+
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTSetVar> set_var = memnew(BTSetVar);
+	set_var->set_variable("health");
+	seq->add_child(set_var);
+	seq->add_child(memnew(BTAlwaysFail));
+	seq->add_child(memnew(BTTestAction));
+	root->add_child(seq);
+
+	Ref<BTProbability> prob = memnew(BTProbability);
+	prob->set_run_chance(0.0);
+	prob->add_child(memnew(BTTestAction));
+	root->add_child(prob);
+
+	for (int i = 0; i < 2; i++) {
+		Ref<BTSubtree> st = memnew(BTSubtree);
+		st->set_subtree(sub);
+		root->add_child(st);
+	}
+
+	Ref<BTAnalyzer> analyzer = memnew(BTAnalyzer);
+
+	SUBCASE("Structure and costs") {
+		Dictionary report = analyzer->analyze_tree(bt);
+		CHECK(int(report["task_count"]) == 14); // * 12 tasks + 2 subtree roots
+		CHECK(int(report["max_depth"]) == 3);
+		CHECK(int(report["expression_evaluations"]) == 2);
+		CHECK(int(report["method_calls"]) == 0);
+		CHECK(int(Dictionary(report["task_counts"])["BTTestAction"]) == 3);
+		CHECK(int(Dictionary(report["task_counts"])["BTSubtree"]) == 2);
+		CHECK(Array(report["errors"]).is_empty());
+
+		Dictionary repeated = report["repeated_subtrees"];
+		REQUIRE(repeated.size() == 1);
+		CHECK(int(repeated.values()[0]) == 2);
+	}
+
+	SUBCASE("Unused variables") {
+		Array unused = Dictionary(analyzer->analyze_tree(bt))["unused_vars"];
+		REQUIRE(unused.size() == 1);
+		CHECK(StringName(unused[0]) == StringName("speed"));
+	}
+
+	SUBCASE("Unreachable tasks") {
+		Array unreachable = Dictionary(analyzer->analyze_tree(bt))["unreachable"];
+		REQUIRE(unreachable.size() == 3);
+		CHECK(String(Dictionary(unreachable[0])["path"]) == "0/0/1");
+		CHECK(String(Dictionary(unreachable[1])["path"]) == "0/1/2");
+		CHECK(String(Dictionary(unreachable[2])["path"]) == "0/2/0");
+	}
+
+	SUBCASE("Subtree errors") {
+		root->add_child(memnew(BTSubtree));
+		Ref<BTSubtree> cycle = memnew(BTSubtree);
+		cycle->set_subtree(bt);
+		sub->get_root_task()->add_child(cycle);
+
+		Array errors = Dictionary(analyzer->analyze_tree(bt))["errors"];
+		CHECK(errors.size() == 3); // * 2 cyclic + 1 unassigned
+
+		sub->get_root_task()->remove_child(cycle);
+	}
+}
+
+} //namespace TestBTAnalyzer
+
+#endif // TEST_BT_ANALYZER_H
@@ -0,0 +1,62 @@
+/**
+ * test_bt_player.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_PLAYER_H
+#define TEST_BT_PLAYER_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_player.h"
+
+namespace TestBTPlayer {
+
+TEST_CASE("[Modules][LimboAI] BTPlayer") {
+	ClassDB::register_class<BTTestAction>();
+
+	Node *agent = memnew(Node);
+	BTPlayer *player = memnew(BTPlayer);
+	agent->add_child(player);
+	player->set_update_mode(BTPlayer::MANUAL);
+	player->set_blackboard(memnew(Blackboard));
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+	bt->set_root_task(task);
+
+#ifdef DEBUG_ENABLED
+	SUBCASE("Monitoring allocations") {
+		// * Enabled while outside of a scene, so no custom monitor is registered.
+		player->set("monitor_allocations", true);
+		player->set_owner(agent);
+		player->set_behavior_tree(bt);
+		REQUIRE(player->get_tree_instance().is_valid());
+
+		for (int i = 0; i < 3; i++) {
+			player->update(0.01666);
+		}
+		CHECK(player->get_alloc_tracker().get_total_ticks() == 3);
+		CHECK(player->get_alloc_tracker().get_max_tick_bytes() >= player->get_alloc_tracker().get_last_tick_bytes());
+
+		player->set("monitor_allocations", false);
+		CHECK(player->get_alloc_tracker().get_total_ticks() == 0);
+		player->update(0.01666);
+		CHECK(player->get_alloc_tracker().get_total_ticks() == 0);
+		CHECK(player->get_last_status() == BTTask::RUNNING);
+	}
+#endif // DEBUG_ENABLED
+
+	memdelete(agent);
+}
+
+} //namespace TestBTPlayer
+
+#endif // TEST_BT_PLAYER_H
@@ -0,0 +1,94 @@
+/**
+ * test_bt_simulator.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_SIMULATOR_H
+#define TEST_BT_SIMULATOR_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_simulator.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+
+namespace TestBTSimulator {
+
+TEST_CASE("[Modules][LimboAI] BTSimulator") {
+	ClassDB::register_class<BTTestAction>();
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task1);
+	seq->add_child(task2);
+	bt->set_root_task(seq);
+
+	Ref<BTSimulator> sim = memnew(BTSimulator);
+	sim->set_behavior_tree(bt);
+
+	SUBCASE("When no agents are spawned") {
+		ERR_PRINT_OFF;
+		CHECK(sim->simulate(10).is_empty());
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("With spawned agents") {
+		Dictionary vars;
+		vars["health"] = 100;
+		sim->set_agent_vars(vars);
+		sim->set_record_trace(true);
+		sim->spawn_agents(8);
+		REQUIRE(sim->get_agent_count() == 8);
+
+		CHECK(sim->get_agent(0) != nullptr);
+		CHECK(sim->get_agent(0) != sim->get_agent(1));
+		CHECK(sim->get_agent_tree_instance(0) != sim->get_agent_tree_instance(1));
+		CHECK(sim->get_agent_tree_instance(0) != seq);
+		CHECK(sim->get_agent_blackboard(3)->get_var("health", 0) == Variant(100));
+
+		SUBCASE("Sequentially") {
+			sim->set_use_threads(false);
+		}
+		SUBCASE("Using threads") {
+			sim->set_use_threads(true);
+		}
+
+		Dictionary stats = sim->simulate(5);
+		CHECK(int(stats["agents"]) == 8);
+		CHECK(int(stats["ticks"]) == 5);
+		CHECK(int(stats["agent_ticks"]) == 40);
+		CHECK(int(stats["running"]) == 8);
+		CHECK(int(stats["total_successes"]) == 0);
+
+		for (int i = 0; i < sim->get_agent_count(); i++) {
+			CHECK(sim->get_agent_last_status(i) == BTTask::RUNNING);
+			PackedByteArray trace = sim->get_agent_trace(i);
+			REQUIRE(trace.size() == 5);
+			for (int t = 0; t < trace.size(); t++) {
+				CHECK(trace[t] == BTTask::RUNNING);
+			}
+			Ref<BTTestAction> running = sim->get_agent_tree_instance(i)->get_child(1);
+			REQUIRE(running.is_valid());
+			CHECK_ENTRIES_TICKS_EXITS(running, 1, 5, 0);
+		}
+
+		// * Template tasks are never ticked.
+		CHECK_ENTRIES_TICKS_EXITS(task2, 0, 0, 0);
+
+		sim->clear();
+		CHECK(sim->get_agent_count() == 0);
+	}
+}
+
+} //namespace TestBTSimulator
+
+#endif // TEST_BT_SIMULATOR_H
@@ -244,6 +244,66 @@ TEST_CASE("[Modules][LimboAI] HSM") {
 		CHECK(hsm->is_active() == false);
 		CHECK(hsm->get_leaf_state() == hsm);
 	}
+	SUBCASE("When a transition is added after initialization") {
+		hsm->dispatch("late_event");
+		CHECK(hsm->get_active_state() == state_alpha);
+
+		hsm->add_transition(state_alpha, state_beta, "late_event");
+		hsm->dispatch("late_event");
+		CHECK(hsm->get_active_state() == state_beta);
+
+		// * Replaces the existing transition for the same state and event.
+		hsm->add_transition(state_beta, nested_hsm, "event_two");
+		hsm->dispatch("event_two");
+		CHECK(hsm->get_active_state() == nested_hsm);
+	}
+	SUBCASE("When a state is freed") {
+		memdelete(state_beta);
+		hsm->dispatch("event_one");
+		CHECK(hsm->get_active_state() == state_alpha);
+		CHECK(alpha_exits->num_callbacks == 0);
+
+		hsm->dispatch("goto_nested");
+		CHECK(hsm->get_active_state() == nested_hsm);
+	}
+	SUBCASE("When an event handler is added after initialization") {
+		Ref<CallbackCounter> handled = memnew(CallbackCounter);
+		state_alpha->add_event_handler("late_event", callable_mp(handled.ptr(), &CallbackCounter::callback_consume));
+		hsm->add_transition(state_alpha, state_beta, "late_event");
+		hsm->dispatch("late_event");
+		CHECK(handled->num_callbacks == 1);
+		CHECK(hsm->get_active_state() == state_alpha); // * consumed by the handler
+	}
+	SUBCASE("Test queued events") {
+		hsm->set_queue_events(true);
+
+		state_alpha->dispatch("event_one");
+		state_alpha->dispatch("event_one"); // * coalesced
+		state_alpha->dispatch("event_two");
+		CHECK(hsm->get_active_state() == state_alpha); // * not processed yet
+		CHECK(hsm->get_queued_event_count() == 2);
+		CHECK(hsm->get_peak_queue_depth() == 2);
+		CHECK(hsm->get_coalesced_event_count() == 1);
+
+		hsm->update(0.01666);
+		CHECK(hsm->get_queued_event_count() == 0);
+		// * Processed in order: alpha -> beta -> alpha.
+		CHECK(alpha_exits->num_callbacks == 1);
+		CHECK(beta_entries->num_callbacks == 1);
+		CHECK(beta_exits->num_callbacks == 1);
+		CHECK(alpha_entries->num_callbacks == 2);
+		CHECK(hsm->get_active_state() == state_alpha);
+		CHECK(alpha_updates->num_callbacks == 1); // * events are processed before states are updated
+
+		hsm->dispatch("goto_nested");
+		CHECK(hsm->get_active_state() == state_alpha);
+		hsm->set_queue_events(false); // * flushes pending events
+		CHECK(hsm->get_active_state() == nested_hsm);
+
+		hsm->reset_queue_stats();
+		CHECK(hsm->get_peak_queue_depth() == 0);
+		CHECK(hsm->get_coalesced_event_count() == 0);
+	}
 	SUBCASE("Test get_root()") {
 		CHECK(hsm->get_root() == hsm);
 		CHECK(state_alpha->get_root() == hsm);
@@ -0,0 +1,143 @@
+/**
+ * test_hsm_batch.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_HSM_BATCH_H
+#define TEST_HSM_BATCH_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/hsm/limbo_hsm_batch.h"
+#include "modules/limboai/hsm/limbo_hsm_definition.h"
+
+namespace TestHSMBatch {
+
+class BatchCallbacks : public RefCounted {
+	GDCLASS(BatchCallbacks, RefCounted);
+
+public:
+	int num_entries = 0;
+	int num_exits = 0;
+	int num_updates = 0;
+	int num_handled = 0;
+	bool permitted_to_enter = true;
+
+	void on_enter(const Variant &p_agent, int p_instance) { num_entries += 1; }
+	void on_exit(const Variant &p_agent, int p_instance) { num_exits += 1; }
+	void on_update(const Variant &p_agent, int p_instance, double p_delta) { num_updates += 1; }
+	bool handler(const Variant &p_agent, int p_instance, const Variant &p_cargo) {
+		num_handled += 1;
+		return true;
+	}
+	bool guard(const Variant &p_agent, int p_instance) { return permitted_to_enter; }
+};
+
+TEST_CASE("[Modules][LimboAI] LimboHSMBatch") {
+	Ref<BatchCallbacks> cb = memnew(BatchCallbacks);
+	Ref<LimboHSMDefinition> def = memnew(LimboHSMDefinition);
+
+	int idle = def->add_state("Idle");
+	int move = def->add_state("Move");
+	int walk = def->add_state("Walk", move);
+	int run = def->add_state("Run", move);
+	def->add_transition(idle, move, "go");
+	def->add_transition(walk, run, "faster");
+	def->add_transition(LimboHSMDefinition::ANYSTATE, idle, "halt");
+	def->add_event_handler(move, "ping", callable_mp(cb.ptr(), &BatchCallbacks::handler));
+	for (int s : { idle, move, walk, run }) {
+		def->set_on_enter(s, callable_mp(cb.ptr(), &BatchCallbacks::on_enter));
+		def->set_on_exit(s, callable_mp(cb.ptr(), &BatchCallbacks::on_exit));
+	}
+	def->set_on_update(move, callable_mp(cb.ptr(), &BatchCallbacks::on_update));
+	def->set_on_update(run, callable_mp(cb.ptr(), &BatchCallbacks::on_update));
+	def->set_guard(run, callable_mp(cb.ptr(), &BatchCallbacks::guard));
+
+	Node *agent = memnew(Node);
+	LimboHSMBatch *batch = memnew(LimboHSMBatch);
+	batch->set_update_mode(LimboHSMBatch::MANUAL);
+	batch->set_definition(def);
+
+	int inst = batch->add_instance(agent);
+	REQUIRE(inst == 0);
+	CHECK(batch->get_instance_count() == 1);
+	CHECK(batch->is_instance_active(inst));
+	CHECK(batch->get_active_state(inst) == idle);
+	CHECK(batch->get_instance_agent(inst) == Variant(agent));
+	CHECK(cb->num_entries == 1);
+
+	SUBCASE("Test transitions and nested states") {
+		CHECK(batch->dispatch(inst, "go"));
+		CHECK(batch->get_active_state(inst) == walk); // * initial child of Move
+		CHECK(batch->is_in_state(inst, move));
+		CHECK_FALSE(batch->is_in_state(inst, idle));
+		CHECK(cb->num_exits == 1);
+		CHECK(cb->num_entries == 3);
+
+		CHECK(batch->dispatch(inst, "faster"));
+		CHECK(batch->get_active_state(inst) == run);
+
+		CHECK(batch->dispatch(inst, "ping")); // * consumed by Move's handler
+		CHECK(cb->num_handled == 1);
+		CHECK(batch->get_active_state(inst) == run);
+
+		CHECK(batch->dispatch(inst, "halt")); // * ANYSTATE at the top level
+		CHECK(batch->get_active_state(inst) == idle);
+		CHECK(cb->num_exits == 4); // * Idle, Walk, Run, Move
+
+		CHECK_FALSE(batch->dispatch(inst, "halt")); // * no self-transition with ANYSTATE
+		CHECK_FALSE(batch->dispatch(inst, "not_found"));
+	}
+	SUBCASE("Test guard") {
+		batch->dispatch(inst, "go");
+		cb->permitted_to_enter = false;
+		CHECK_FALSE(batch->dispatch(inst, "faster"));
+		CHECK(batch->get_active_state(inst) == walk);
+		cb->permitted_to_enter = true;
+		CHECK(batch->dispatch(inst, "faster"));
+		CHECK(batch->get_active_state(inst) == run);
+	}
+	SUBCASE("Test update") {
+		batch->update(0.01666);
+		CHECK(cb->num_updates == 0); // * Idle has no update callable
+		batch->dispatch(inst, "go");
+		batch->update(0.01666);
+		CHECK(cb->num_updates == 1); // * Move
+		batch->dispatch(inst, "faster");
+		batch->update(0.01666);
+		CHECK(cb->num_updates == 3); // * Move and Run
+	}
+	SUBCASE("Test finished") {
+		batch->dispatch(inst, "go");
+		CHECK_FALSE(batch->dispatch(inst, LW_NAME(EVENT_FINISHED)));
+		CHECK_FALSE(batch->is_instance_active(inst));
+		CHECK(cb->num_exits == 3); // * Idle, Walk, Move
+		CHECK_FALSE(batch->dispatch(inst, "halt"));
+	}
+	SUBCASE("Test many instances") {
+		for (int i = 1; i < 100; i++) {
+			CHECK(batch->add_instance(agent) == i);
+		}
+		CHECK(batch->dispatch_all("go") == 100);
+		CHECK(batch->get_active_state(50) == walk);
+
+		batch->remove_instance(50);
+		CHECK(batch->get_instance_count() == 99);
+		CHECK(batch->dispatch_all("faster") == 99);
+		CHECK(batch->add_instance(agent) == 50); // * slot is reused
+		CHECK(batch->get_active_state(50) == idle);
+	}
+
+	memdelete(batch);
+	memdelete(agent);
+}
+
+} //namespace TestHSMBatch
+
+#endif // TEST_HSM_BATCH_H
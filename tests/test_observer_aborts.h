@@ -0,0 +1,175 @@
+/**
+ * test_observer_aborts.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_OBSERVER_ABORTS_H
+#define TEST_OBSERVER_ABORTS_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_trigger.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+
+namespace TestObserverAborts {
+
+TEST_CASE("[Modules][LimboAI] Observer aborts lower priority") {
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("enemy_visible", false);
+
+	Ref<BTCheckVar> check = memnew(BTCheckVar);
+	check->set_variable("enemy_visible");
+	Ref<BBVariant> expected = memnew(BBVariant);
+	expected->set_saved_value(true);
+	check->set_value(expected);
+	check->set_observer_aborts(BTCondition::OBSERVER_ABORTS_LOWER_PRIORITY);
+
+	Ref<BTSelector> sel = memnew(BTSelector);
+	Ref<BTSequence> attack_seq = memnew(BTSequence);
+	Ref<BTTestAction> attack = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestAction> patrol = memnew(BTTestAction(BTTask::RUNNING));
+	attack_seq->add_child(check);
+	attack_seq->add_child(attack);
+	sel->add_child(attack_seq);
+	sel->add_child(patrol);
+	sel->initialize(agent, bb, agent);
+
+	CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+	CHECK(check->get_status() == BTTask::FAILURE);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::FRESH, 0, 0, 0);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(patrol, BTTask::RUNNING, 1, 1, 0);
+
+	SUBCASE("Higher priority branch is not re-evaluated while variables are unchanged") {
+		expected->set_saved_value(false); // * Would pass if re-evaluated.
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::FRESH, 0, 0, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(patrol, BTTask::RUNNING, 1, 2, 0);
+	}
+
+	SUBCASE("Running branch is aborted when condition passes") {
+		bb->set_var("enemy_visible", true);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::RUNNING, 1, 1, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(patrol, BTTask::FRESH, 1, 1, 1);
+
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::RUNNING, 1, 2, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(patrol, BTTask::FRESH, 1, 1, 1);
+	}
+
+	SUBCASE("Running branch continues when condition still fails") {
+		bb->set_var("enemy_visible", false);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::FRESH, 0, 0, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(patrol, BTTask::RUNNING, 1, 2, 0);
+	}
+
+	SUBCASE("Without observer aborts") {
+		check->set_observer_aborts(BTCondition::OBSERVER_ABORTS_NONE);
+		sel->initialize(agent, bb, agent);
+		bb->set_var("enemy_visible", true);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::FRESH, 0, 0, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(patrol, BTTask::RUNNING, 1, 2, 0);
+	}
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI] Observer aborts self") {
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("enemy_visible", true);
+
+	Ref<BTCheckVar> check = memnew(BTCheckVar);
+	check->set_variable("enemy_visible");
+	Ref<BBVariant> expected = memnew(BBVariant);
+	expected->set_saved_value(true);
+	check->set_value(expected);
+	check->set_observer_aborts(BTCondition::OBSERVER_ABORTS_SELF);
+
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> attack = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(check);
+	seq->add_child(attack);
+	seq->initialize(agent, bb, agent);
+
+	CHECK(seq->execute(0.01666) == BTTask::RUNNING);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::RUNNING, 1, 1, 0);
+
+	SUBCASE("Sequence continues while condition holds") {
+		bb->set_var("enemy_visible", true);
+		CHECK(seq->execute(0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::RUNNING, 1, 2, 0);
+	}
+
+	SUBCASE("Sequence fails when condition no longer holds") {
+		bb->set_var("enemy_visible", false);
+		CHECK(seq->execute(0.01666) == BTTask::FAILURE);
+		CHECK(check->get_status() == BTTask::FAILURE);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(attack, BTTask::FRESH, 1, 1, 1);
+	}
+
+	SUBCASE("When value is a blackboard variable") {
+		bb->set_var("expected_visibility", true);
+		expected->set_value_source(BBParam::BLACKBOARD_VAR);
+		expected->set_variable("expected_visibility");
+		seq->initialize(agent, bb, agent);
+		CHECK(seq->execute(0.01666) == BTTask::RUNNING);
+
+		bb->set_var("expected_visibility", false);
+		CHECK(seq->execute(0.01666) == BTTask::FAILURE);
+	}
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI] Observer aborts with BTCheckTrigger") {
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("alarm", false);
+
+	Ref<BTCheckTrigger> trigger = memnew(BTCheckTrigger);
+	trigger->set_variable("alarm");
+	trigger->set_observer_aborts(BTCondition::OBSERVER_ABORTS_BOTH);
+
+	Ref<BTSelector> sel = memnew(BTSelector);
+	Ref<BTSequence> alarm_seq = memnew(BTSequence);
+	Ref<BTTestAction> respond = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestAction> idle = memnew(BTTestAction(BTTask::RUNNING));
+	alarm_seq->add_child(trigger);
+	alarm_seq->add_child(respond);
+	sel->add_child(alarm_seq);
+	sel->add_child(idle);
+	sel->initialize(agent, bb, agent);
+
+	CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(idle, BTTask::RUNNING, 1, 1, 0);
+
+	bb->set_var("alarm", true);
+	CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+	CHECK(bb->get_var("alarm", Variant()) == Variant(false));
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(respond, BTTask::RUNNING, 1, 1, 0);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(idle, BTTask::FRESH, 1, 1, 1);
+
+	// * Consuming the trigger doesn't abort the branch that consumed it.
+	CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(respond, BTTask::RUNNING, 1, 2, 0);
+
+	memdelete(agent);
+}
+
+} //namespace TestObserverAborts
+
+#endif // TEST_OBSERVER_ABORTS_H
@@ -157,6 +157,106 @@ TEST_CASE("[Modules][LimboAI] BTProbabilitySelector") {
 		CHECK(task3->num_ticks > 5750);
 		CHECK(task3->num_ticks < 6750);
 	}
+	SUBCASE("When weights change after execution") {
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::SUCCESS;
+		task3->ret_status = BTTask::SUCCESS;
+
+		sel->set_weight(0, 1.0);
+		sel->set_weight(1, 0.0);
+		sel->set_weight(2, 0.0);
+		for (int i = 0; i < 10; i++) {
+			sel->execute(0.01666);
+		}
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 10, 10, 10);
+
+		sel->set_weight(0, 0.0);
+		sel->set_weight(2, 1.0);
+		for (int i = 0; i < 10; i++) {
+			sel->execute(0.01666);
+		}
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 10, 10, 10);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 0, 0, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::SUCCESS, 10, 10, 10);
+	}
+	SUBCASE("When weights are edited through metadata") {
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::SUCCESS;
+		task3->ret_status = BTTask::SUCCESS;
+
+		sel->set_weight(0, 1.0);
+		sel->set_weight(1, 0.0);
+		sel->set_weight(2, 0.0);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+
+		// * Cached weights are kept until the tree is set up again.
+		task1->set_meta("_weight_", 0.0);
+		task3->set_meta("_weight_", 1.0);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 2, 2, 2);
+
+		Node *dummy = memnew(Node);
+		sel->initialize(dummy, memnew(Blackboard), dummy);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 2, 2, 2);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::SUCCESS, 1, 1, 1);
+		memdelete(dummy);
+	}
+	SUBCASE("When a child is replaced") {
+		task1->ret_status = BTTask::SUCCESS;
+		sel->set_weight(0, 1.0);
+		sel->set_weight(1, 0.0);
+		sel->set_weight(2, 0.0);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+
+		// * Same child count, but the only child with weight is gone.
+		sel->remove_child(task1);
+		Ref<BTTestAction> task4 = memnew(BTTestAction(BTTask::SUCCESS));
+		task4->set_meta("_weight_", 0.0);
+		sel->add_child(task4);
+		task2->ret_status = BTTask::SUCCESS;
+		CHECK(sel->execute(0.01666) == BTTask::FAILURE);
+		CHECK(task2->num_entries == 0);
+		CHECK(task4->num_entries == 0);
+	}
+	SUBCASE("With failures excluded from reselection") {
+		task1->ret_status = BTTask::FAILURE;
+		task2->ret_status = BTTask::FAILURE;
+		task3->ret_status = BTTask::SUCCESS;
+
+		for (int i = 1; i <= 100; i++) {
+			CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+			// * A failed child must not be selected again during the same execution.
+			CHECK(task1->num_entries <= i);
+			CHECK(task2->num_entries <= i);
+			CHECK(task3->num_entries == i);
+		}
+	}
+	SUBCASE("With the same seed") {
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::SUCCESS;
+		task3->ret_status = BTTask::SUCCESS;
+
+		Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+		sel->set_rng(rng);
+
+		rng->set_seed(42);
+		for (int i = 0; i < 100; i++) {
+			sel->execute(0.01666);
+		}
+		int ticks1 = task1->num_ticks;
+		int ticks2 = task2->num_ticks;
+		int ticks3 = task3->num_ticks;
+
+		rng->set_seed(42);
+		for (int i = 0; i < 100; i++) {
+			sel->execute(0.01666);
+		}
+		CHECK(task1->num_ticks == ticks1 * 2);
+		CHECK(task2->num_ticks == ticks2 * 2);
+		CHECK(task3->num_ticks == ticks3 * 2);
+	}
 	SUBCASE("Test abort_on_failure") {
 		task1->ret_status = BTTask::FAILURE;
 		task2->ret_status = BTTask::FAILURE;
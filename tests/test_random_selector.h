@@ -14,6 +14,7 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/bt/behavior_tree.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/composites/bt_random_selector.h"
 
@@ -100,6 +101,47 @@ TEST_CASE("[Modules][LimboAI] BTRandomSelector") {
 	}
 }
 
+TEST_CASE("[Modules][LimboAI] BTRandomSelector with a seeded RNG") {
+	ClassDB::register_class<BTTestAction>();
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTRandomSelector> sel = memnew(BTRandomSelector);
+	for (int i = 0; i < 5; i++) {
+		sel->add_child(memnew(BTTestAction(BTTask::RUNNING)));
+	}
+	bt->set_root_task(sel);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	// * Returns indices of children picked first in a series of executions.
+	auto pick_sequence = [&](int64_t p_seed) {
+		Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+		rng->set_seed(p_seed);
+		Ref<BTTask> inst = bt->instantiate(dummy, bb, dummy, rng);
+		CHECK(inst->get_rng() == rng);
+		CHECK(inst->get_child(0)->get_rng() == rng);
+
+		Vector<int> picks;
+		for (int n = 0; n < 20; n++) {
+			CHECK(inst->execute(0.01666) == BTTask::RUNNING);
+			for (int i = 0; i < inst->get_child_count(); i++) {
+				if (inst->get_child(i)->get_status() == BTTask::RUNNING) {
+					picks.push_back(i);
+				}
+			}
+			inst->abort();
+		}
+		return picks;
+	};
+
+	Vector<int> picks = pick_sequence(42);
+	CHECK(picks.size() == 20);
+	CHECK(picks == pick_sequence(42));
+
+	memdelete(dummy);
+}
+
 TEST_CASE("[Modules][LimboAI] Empty BTRandomSelector returns FAILURE") {
 	Ref<BTRandomSelector> seq = memnew(BTRandomSelector);
 	CHECK(seq->execute(0.01666) == BTTask::FAILURE);
@@ -0,0 +1,149 @@
+/**
+ * test_resume_cursor.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_RESUME_CURSOR_H
+#define TEST_RESUME_CURSOR_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/bt_resume_cursor.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_succeed.h"
+#include "modules/limboai/bt/tasks/decorators/bt_invert.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat.h"
+#include "modules/limboai/bt/tasks/decorators/bt_time_limit.h"
+
+namespace TestResumeCursor {
+
+// Leaves are returned in r_leaves: 0 - guarded by invert, 1 - fallback in dynamic selector, 2 - time-limited, 3 - last.
+static Ref<BTTask> _make_tree(Vector<Ref<BTTestAction>> &r_leaves) {
+	r_leaves.clear();
+	r_leaves.push_back(memnew(BTTestAction(BTTask::FAILURE)));
+	r_leaves.push_back(memnew(BTTestAction(BTTask::RUNNING)));
+	r_leaves.push_back(memnew(BTTestAction(BTTask::RUNNING)));
+	r_leaves.push_back(memnew(BTTestAction(BTTask::RUNNING)));
+
+	Ref<BTInvert> invert = memnew(BTInvert);
+	invert->add_child(r_leaves[0]);
+	Ref<BTAlwaysSucceed> always_succeed = memnew(BTAlwaysSucceed);
+	always_succeed->add_child(invert);
+
+	Ref<BTDynamicSelector> dyn = memnew(BTDynamicSelector);
+	Ref<BTSequence> guarded = memnew(BTSequence);
+	guarded->add_child(memnew(BTTestAction(BTTask::FAILURE)));
+	dyn->add_child(guarded);
+	dyn->add_child(r_leaves[1]);
+
+	Ref<BTTimeLimit> time_limit = memnew(BTTimeLimit);
+	time_limit->set_time_limit(0.05);
+	time_limit->add_child(r_leaves[2]);
+	Ref<BTSelector> sel = memnew(BTSelector);
+	sel->add_child(time_limit);
+	sel->add_child(dyn);
+
+	Ref<BTSequence> inner = memnew(BTSequence);
+	inner->add_child(always_succeed);
+	inner->add_child(sel);
+	Ref<BTRepeat> repeat = memnew(BTRepeat);
+	repeat->set_times(2);
+	repeat->add_child(inner);
+
+	Ref<BTSequence> root = memnew(BTSequence);
+	root->add_child(repeat);
+	root->add_child(r_leaves[3]);
+	return root;
+}
+
+static void _collect_state(const Ref<BTTask> &p_task, Array &r_state) {
+	r_state.push_back(p_task->get_status());
+	r_state.push_back(p_task->get_elapsed_time());
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		_collect_state(p_task->get_child(i), r_state);
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] BTResumeCursor") {
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Vector<Ref<BTTestAction>> leaves;
+	Ref<BTTask> root = _make_tree(leaves);
+	root->initialize(agent, bb, agent);
+	BTResumeCursor cursor;
+
+	SUBCASE("Resumes at the deepest running task") {
+		CHECK(cursor.execute(root, 0.01666) == BTTask::RUNNING);
+		// * root > repeat > inner > sel > time_limit
+		CHECK(cursor.get_depth() == 5);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[2], BTTask::RUNNING, 1, 1, 0);
+
+		CHECK(cursor.execute(root, 0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[2], BTTask::RUNNING, 1, 2, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[0], BTTask::FAILURE, 1, 1, 1);
+		CHECK(root->get_elapsed_time() == doctest::Approx(0.01666));
+	}
+
+	SUBCASE("Propagates a finished result to the parent") {
+		leaves[2]->ret_status = BTTask::SUCCESS;
+		CHECK(cursor.execute(root, 0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[2], BTTask::SUCCESS, 1, 1, 1);
+		// * Second iteration of repeat.
+		CHECK(cursor.execute(root, 0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[2], BTTask::SUCCESS, 2, 2, 2);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[3], BTTask::RUNNING, 1, 1, 0);
+		CHECK(cursor.get_depth() == 2);
+
+		leaves[3]->ret_status = BTTask::SUCCESS;
+		CHECK(cursor.execute(root, 0.01666) == BTTask::SUCCESS);
+		CHECK(root->get_status() == BTTask::SUCCESS);
+		CHECK(cursor.get_depth() == 0);
+	}
+
+	SUBCASE("Recovers when the tree is aborted") {
+		CHECK(cursor.execute(root, 0.01666) == BTTask::RUNNING);
+		root->abort();
+		CHECK(cursor.execute(root, 0.01666) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(leaves[2], BTTask::RUNNING, 2, 2, 1);
+	}
+
+	SUBCASE("Same results as executing from the root") {
+		Vector<Ref<BTTestAction>> ref_leaves;
+		Ref<BTTask> ref_root = _make_tree(ref_leaves);
+		ref_root->initialize(agent, bb, agent);
+
+		for (int tick = 0; tick < 20; tick++) {
+			if (tick == 8) {
+				// * Fails the guard and finishes the first iteration of repeat.
+				leaves[0]->ret_status = BTTask::SUCCESS;
+				ref_leaves[0]->ret_status = BTTask::SUCCESS;
+			} else if (tick == 12) {
+				leaves[1]->ret_status = BTTask::FAILURE;
+				ref_leaves[1]->ret_status = BTTask::FAILURE;
+			}
+			CHECK(cursor.execute(root, 0.01666) == ref_root->execute(0.01666));
+
+			Array state;
+			Array ref_state;
+			_collect_state(root, state);
+			_collect_state(ref_root, ref_state);
+			CHECK(state == ref_state);
+		}
+	}
+
+	memdelete(agent);
+}
+
+} //namespace TestResumeCursor
+
+#endif // TEST_RESUME_CURSOR_H
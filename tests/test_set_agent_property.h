@@ -40,6 +40,14 @@ TEST_CASE("[Modules][LimboAI] BTSetAgentProperty") {
 		CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
 		CHECK(agent->get_process_priority() == 7);
 	}
+	SUBCASE("With accessors resolved during setup") {
+		sap->initialize(agent, bb, agent);
+		CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(agent->get_process_priority() == 7);
+		sap->set_operation(LimboUtility::OPERATION_ADDITION);
+		CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(agent->get_process_priority() == 14);
+	}
 	SUBCASE("When value is not set") {
 		sap->set_value(nullptr);
 		ERR_PRINT_OFF;
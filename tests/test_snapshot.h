@@ -0,0 +1,227 @@
+/**
+ * test_snapshot.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_SNAPSHOT_H
+#define TEST_SNAPSHOT_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_random_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait_ticks.h"
+#include "modules/limboai/hsm/limbo_hsm.h"
+#include "modules/limboai/hsm/limbo_state.h"
+#include "modules/limboai/util/limbo_binary_io.h"
+
+namespace TestSnapshot {
+
+inline void capture_statuses(const Ref<BTTask> &p_task, Vector<int> &r_trace) {
+	r_trace.push_back(p_task->get_status());
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		capture_statuses(p_task->get_child(i), r_trace);
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] BTTask snapshots") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTRepeat> repeat = memnew(BTRepeat);
+	repeat->set_times(3);
+	Ref<BTWaitTicks> wait = memnew(BTWaitTicks);
+	wait->set_num_ticks(2);
+	repeat->add_child(wait);
+	Ref<BTRandomSelector> sel = memnew(BTRandomSelector);
+	sel->add_child(memnew(BTTestAction(BTTask::FAILURE)));
+	sel->add_child(memnew(BTTestAction(BTTask::SUCCESS)));
+	sel->add_child(memnew(BTTestAction(BTTask::FAILURE)));
+	root->add_child(repeat);
+	root->add_child(sel);
+
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(1234);
+	root->set_rng(rng);
+	root->initialize(dummy, bb, dummy);
+
+	for (int i = 0; i < 5; i++) {
+		root->execute(0.01666);
+	}
+	REQUIRE(wait->get_status() == BTTask::RUNNING);
+
+	SUBCASE("Restored tree behaves identically") {
+		PackedByteArray snapshot = root->save_state();
+
+		Vector<int> trace_before;
+		for (int i = 0; i < 30; i++) {
+			root->execute(0.01666);
+			capture_statuses(root, trace_before);
+		}
+
+		CHECK(root->load_state(snapshot) == OK);
+		CHECK(wait->get_status() == BTTask::RUNNING);
+
+		Vector<int> trace_after;
+		for (int i = 0; i < 30; i++) {
+			root->execute(0.01666);
+			capture_statuses(root, trace_after);
+		}
+		CHECK(trace_before == trace_after);
+	}
+	SUBCASE("When tree structure doesn't match") {
+		PackedByteArray snapshot = root->save_state();
+		sel->add_child(memnew(BTTestAction));
+		ERR_PRINT_OFF;
+		CHECK(root->load_state(snapshot) == ERR_INVALID_DATA);
+		CHECK(root->load_state(PackedByteArray()) == ERR_FILE_UNRECOGNIZED);
+		ERR_PRINT_ON;
+	}
+	SUBCASE("When restoring fails partway") {
+		// * Let the random selector generate its order of children.
+		for (int i = 0; i < 20 && sel->get_status() == BTTask::FRESH; i++) {
+			root->execute(0.01666);
+		}
+		REQUIRE(sel->get_status() != BTTask::FRESH);
+		PackedByteArray snapshot = root->save_state();
+		for (int i = 0; i < 3; i++) {
+			root->execute(0.01666);
+		}
+		PackedByteArray current = root->save_state();
+		REQUIRE(current != snapshot);
+
+		// * Random selector is saved last, followed by its 3 children of 17 bytes each.
+		const int64_t indicies_end = snapshot.size() - 3 * 17;
+		const int64_t first_idx_pos = indicies_end - 3 * 4;
+		const int64_t running_idx_pos = first_idx_pos - 8;
+
+		PackedByteArray out_of_range = snapshot.duplicate();
+		out_of_range.encode_s32(indicies_end - 4, 3);
+		PackedByteArray duplicated = snapshot.duplicate();
+		duplicated.encode_s32(indicies_end - 4, snapshot.decode_s32(first_idx_pos));
+		PackedByteArray bad_running_idx = snapshot.duplicate();
+		bad_running_idx.encode_s32(running_idx_pos, -1);
+
+		ERR_PRINT_OFF;
+		CHECK(root->load_state(out_of_range) == ERR_INVALID_DATA);
+		CHECK(root->save_state() == current);
+		CHECK(root->load_state(duplicated) == ERR_INVALID_DATA);
+		CHECK(root->save_state() == current);
+		CHECK(root->load_state(bad_running_idx) == ERR_INVALID_DATA);
+		CHECK(root->save_state() == current);
+		ERR_PRINT_ON;
+
+		CHECK(root->load_state(snapshot) == OK);
+		CHECK(root->save_state() == snapshot);
+	}
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] Blackboard snapshots") {
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("health", 100);
+	bb->set_var("target", Vector2(1.0, 2.0));
+	bb->set_var("name", "Blob");
+
+	PackedByteArray snapshot = bb->save_state();
+	bb->set_var("health", 10);
+	bb->set_var("target", Vector2());
+	bb->set_var("added_later", true);
+
+	SUBCASE("Restoring") {
+		CHECK(bb->load_state(snapshot) == OK);
+		CHECK(bb->get_var("health") == Variant(100));
+		CHECK(bb->get_var("target") == Variant(Vector2(1.0, 2.0)));
+		CHECK(bb->get_var("name") == Variant("Blob"));
+		CHECK_FALSE(bb->has_var("added_later"));
+	}
+	SUBCASE("With corrupted data") {
+		snapshot.resize(snapshot.size() - 2);
+		ERR_PRINT_OFF;
+		CHECK(bb->load_state(snapshot) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+		// * Nothing is applied.
+		CHECK(bb->get_var("health") == Variant(10));
+		CHECK(bb->get_var("target") == Variant(Vector2()));
+		CHECK(bb->has_var("added_later"));
+	}
+	SUBCASE("With a corrupt length prefix") {
+		// * Lengths that overflow the read position must not pass the bounds check.
+		LimboBinaryWriter name_writer;
+		name_writer.put_u32(1);
+		name_writer.put_u32(0xFFFFFFFF);
+		name_writer.put_u32(0);
+		LimboBinaryWriter value_writer;
+		value_writer.put_u32(1);
+		value_writer.put_string_name("health");
+		value_writer.put_u32(0xFFFFFFFE);
+		value_writer.put_u32(0);
+		ERR_PRINT_OFF;
+		CHECK(bb->load_state(name_writer.to_packed()) == ERR_INVALID_DATA);
+		CHECK(bb->load_state(value_writer.to_packed()) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+		CHECK(bb->get_var("health") == Variant(10));
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] LimboHSM snapshots") {
+	Node *agent = memnew(Node);
+	LimboHSM *hsm = memnew(LimboHSM);
+	LimboState *state_alpha = memnew(LimboState);
+	LimboHSM *nested_hsm = memnew(LimboHSM);
+	LimboState *state_gamma = memnew(LimboState);
+	LimboState *state_delta = memnew(LimboState);
+	hsm->add_child(state_alpha);
+	hsm->add_child(nested_hsm);
+	nested_hsm->add_child(state_gamma);
+	nested_hsm->add_child(state_delta);
+
+	Ref<CallbackCounter> delta_entries = memnew(CallbackCounter);
+	Ref<CallbackCounter> delta_exits = memnew(CallbackCounter);
+	state_delta->call_on_enter(callable_mp(delta_entries.ptr(), &CallbackCounter::callback));
+	state_delta->call_on_exit(callable_mp(delta_exits.ptr(), &CallbackCounter::callback));
+
+	hsm->add_transition(hsm->anystate(), nested_hsm, "goto_nested");
+	hsm->add_transition(hsm->anystate(), state_alpha, "goto_alpha");
+	nested_hsm->add_transition(state_gamma, state_delta, "goto_delta");
+
+	hsm->set_update_mode(LimboHSM::MANUAL);
+	hsm->initialize(agent);
+	hsm->set_active(true);
+	hsm->dispatch("goto_nested");
+	hsm->dispatch("goto_delta");
+	REQUIRE(hsm->get_leaf_state() == state_delta);
+
+	PackedByteArray snapshot = hsm->save_state();
+	hsm->dispatch("goto_alpha");
+	REQUIRE(hsm->get_leaf_state() == state_alpha);
+	REQUIRE(delta_exits->num_callbacks == 1);
+
+	CHECK(hsm->load_state(snapshot) == OK);
+	CHECK(hsm->get_leaf_state() == state_delta);
+	CHECK(nested_hsm->is_active());
+	CHECK(state_delta->is_active());
+	CHECK_FALSE(state_alpha->is_active());
+	CHECK(delta_entries->num_callbacks == 1); // * restored without callbacks
+
+	hsm->dispatch("goto_alpha");
+	CHECK(hsm->get_leaf_state() == state_alpha);
+	CHECK(delta_exits->num_callbacks == 2);
+
+	memdelete(agent);
+	memdelete(hsm);
+}
+
+} //namespace TestSnapshot
+
+#endif // TEST_SNAPSHOT_H
@@ -0,0 +1,119 @@
+/**
+ * test_task_tree.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_TASK_TREE_H
+#define TEST_TASK_TREE_H
+
+#ifdef TOOLS_ENABLED
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
+#include "modules/limboai/editor/task_tree.h"
+
+namespace TestTaskTree {
+
+// Checks that each task under p_task has an item in the matching position.
+static void check_items(TaskTree *p_task_tree, const Ref<BTTask> &p_task) {
+	TreeItem *item = p_task_tree->get_task_item(p_task);
+	REQUIRE(item != nullptr);
+	CHECK(Ref<BTTask>(item->get_metadata(0)) == p_task);
+	CHECK(item->get_child_count() == p_task->get_child_count());
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		TreeItem *child_item = p_task_tree->get_task_item(p_task->get_child(i));
+		REQUIRE(child_item != nullptr);
+		CHECK(child_item->get_parent() == item);
+		CHECK(child_item->get_index() == i);
+		check_items(p_task_tree, p_task->get_child(i));
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] TaskTree") {
+	ClassDB::register_class<BTTestAction>();
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTTestAction> task_a = memnew(BTTestAction);
+	Ref<BTSequence> task_b = memnew(BTSequence);
+	Ref<BTTestAction> task_c = memnew(BTTestAction);
+	Ref<BTTestAction> task_d = memnew(BTTestAction);
+	root->add_child(task_a);
+	root->add_child(task_b);
+	root->add_child(task_c);
+	task_b->add_child(task_d);
+	bt->set_root_task(root);
+
+	TaskTree *task_tree = memnew(TaskTree);
+	task_tree->load_bt(bt);
+	check_items(task_tree, root);
+	TreeItem *item_b = task_tree->get_task_item(task_b);
+
+	SUBCASE("When a task is added") {
+		Ref<BTTestAction> task_e = memnew(BTTestAction);
+		root->add_child_at_index(task_e, 1);
+		task_tree->update_tree();
+		check_items(task_tree, root);
+		CHECK(task_tree->get_task_item(task_b) == item_b); // * reused
+	}
+	SUBCASE("When a task is removed") {
+		root->remove_child(task_a);
+		task_tree->update_tree();
+		check_items(task_tree, root);
+		CHECK(task_tree->get_task_item(task_a) == nullptr);
+	}
+	SUBCASE("When tasks are moved") {
+		root->remove_child(task_c);
+		root->add_child_at_index(task_c, 0);
+		task_b->remove_child(task_d);
+		root->add_child(task_d);
+		task_tree->update_tree();
+		check_items(task_tree, root);
+		CHECK(task_tree->get_task_item(task_b) == item_b);
+		CHECK(task_tree->get_task_item(task_d)->get_parent() == task_tree->get_task_item(root));
+	}
+	SUBCASE("When a task is inside a collapsed branch") {
+		task_b->set_display_collapsed(true);
+		task_tree->load_bt(bt);
+		TreeItem *item_d = task_tree->get_task_item(task_d);
+		REQUIRE(item_d != nullptr);
+		CHECK(Ref<BTTask>(item_d->get_metadata(0)) == task_d);
+		CHECK(item_d->get_parent() == task_tree->get_task_item(task_b));
+		CHECK(task_tree->get_task_item(task_b)->is_collapsed());
+	}
+	SUBCASE("When a task that is not selected changes") {
+		Ref<BTWait> task_wait = memnew(BTWait);
+		task_wait->set_duration(1.0);
+		root->add_child(task_wait);
+		task_tree->update_tree();
+		TreeItem *item_wait = task_tree->get_task_item(task_wait);
+		REQUIRE(item_wait != nullptr);
+		CHECK(item_wait->get_text(0) == "Wait 1 sec");
+		task_wait->set_duration(2.0);
+		CHECK(item_wait->get_text(0) == "Wait 2 sec");
+	}
+	SUBCASE("When all items are refreshed") {
+		task_b->set_custom_name("Renamed");
+		task_tree->refresh_all_items();
+		CHECK(item_b->get_text(0) == "Renamed");
+		check_items(task_tree, root);
+	}
+
+	task_tree->unload();
+	memdelete(task_tree);
+}
+
+} //namespace TestTaskTree
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_TASK_TREE_H
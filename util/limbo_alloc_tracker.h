@@ -0,0 +1,79 @@
+/**
+ * limbo_alloc_tracker.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_ALLOC_TRACKER_H
+#define LIMBO_ALLOC_TRACKER_H
+
+#include "limbo_compat.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/os/memory.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/os.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+// Tracks memory allocated while instantiating and ticking a single tree instance.
+// It samples the engine's static memory usage counter before and after each operation,
+// so it measures net bytes (allocated minus freed) and relies on the counter that the
+// engine maintains only in debug builds. The engine doesn't count allocations, so memory
+// that is allocated and freed within the same operation is not reflected: these are
+// figures of memory retained, not of allocation churn. The counter is global: allocations made by
+// other threads during the measured operation are included as well.
+class LimboAllocTracker {
+private:
+	uint64_t mark = 0;
+
+	int64_t instantiate_bytes = 0;
+	int64_t last_tick_bytes = 0;
+	int64_t max_tick_bytes = 0;
+	int64_t total_tick_bytes = 0;
+	uint64_t total_ticks = 0;
+
+	// Accumulated between reads of the performance monitor.
+	int64_t tick_bytes_acc = 0;
+	uint64_t tick_bytes_n = 0;
+
+	_FORCE_INLINE_ int64_t _get_delta() const { return int64_t(GET_MEM_USAGE()) - int64_t(mark); }
+
+public:
+	_FORCE_INLINE_ void begin() { mark = GET_MEM_USAGE(); }
+
+	_FORCE_INLINE_ void end_instantiate() { instantiate_bytes = _get_delta(); }
+
+	_FORCE_INLINE_ void end_tick() {
+		last_tick_bytes = _get_delta();
+		max_tick_bytes = MAX(max_tick_bytes, last_tick_bytes);
+		total_tick_bytes += last_tick_bytes;
+		total_ticks += 1;
+		tick_bytes_acc += last_tick_bytes;
+		tick_bytes_n += 1;
+	}
+
+	int64_t get_instantiate_bytes() const { return instantiate_bytes; }
+	int64_t get_last_tick_bytes() const { return last_tick_bytes; }
+	int64_t get_max_tick_bytes() const { return max_tick_bytes; }
+	uint64_t get_total_ticks() const { return total_ticks; }
+	double get_mean_tick_bytes() const { return total_ticks ? double(total_tick_bytes) / double(total_ticks) : 0.0; }
+
+	// Returns mean bytes per tick since the previous call.
+	double pop_mean_tick_bytes() {
+		double mean = tick_bytes_n ? double(tick_bytes_acc) / double(tick_bytes_n) : 0.0;
+		tick_bytes_acc = 0;
+		tick_bytes_n = 0;
+		return mean;
+	}
+
+	void reset() { *this = LimboAllocTracker(); }
+};
+
+#endif // LIMBO_ALLOC_TRACKER_H
@@ -0,0 +1,214 @@
+/**
+ * limbo_binary_io.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_BINARY_IO_H
+#define LIMBO_BINARY_IO_H
+
+#include "limbo_compat.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/io/marshalls.h"
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/variant.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+#include <string.h>
+
+// Minimal binary writer and reader for runtime snapshots.
+// Values are stored in host byte order (little-endian on all supported platforms).
+// Top-level object values are stored by instance ID, so they can only be restored within the same session.
+#define LIMBO_BINARY_OBJECT_ID 0xFFFFFFFF
+
+class LimboBinaryWriter {
+private:
+	LocalVector<uint8_t> buffer;
+
+	_FORCE_INLINE_ uint8_t *_grow(uint32_t p_size) {
+		uint32_t pos = buffer.size();
+		buffer.resize(pos + p_size);
+		return buffer.ptr() + pos;
+	}
+
+public:
+	_FORCE_INLINE_ void put_u8(uint8_t p_value) { buffer.push_back(p_value); }
+	_FORCE_INLINE_ void put_u32(uint32_t p_value) { memcpy(_grow(4), &p_value, 4); }
+	_FORCE_INLINE_ void put_i32(int32_t p_value) { memcpy(_grow(4), &p_value, 4); }
+	_FORCE_INLINE_ void put_u64(uint64_t p_value) { memcpy(_grow(8), &p_value, 8); }
+	_FORCE_INLINE_ void put_double(double p_value) { memcpy(_grow(8), &p_value, 8); }
+	_FORCE_INLINE_ void put_bytes(const uint8_t *p_data, uint32_t p_size) {
+		if (p_size > 0) {
+			memcpy(_grow(p_size), p_data, p_size);
+		}
+	}
+
+	void put_string_name(const StringName &p_name) {
+		CharString utf8 = String(p_name).utf8();
+		put_u32(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void put_var(const Variant &p_value) {
+		if (p_value.get_type() == Variant::OBJECT) {
+			Object *obj = p_value;
+			put_u32(LIMBO_BINARY_OBJECT_ID);
+			put_u64(obj ? uint64_t(obj->get_instance_id()) : 0);
+			return;
+		}
+#ifdef LIMBOAI_MODULE
+		int len = 0;
+		Error err = encode_variant(p_value, nullptr, len, false);
+		ERR_FAIL_COND(err != OK);
+		put_u32(len);
+		encode_variant(p_value, _grow(len), len, false);
+#elif LIMBOAI_GDEXTENSION
+		PackedByteArray bytes = UtilityFunctions::var_to_bytes(p_value);
+		put_u32(bytes.size());
+		put_bytes(bytes.ptr(), bytes.size());
+#endif
+	}
+
+	// Reserves a 32-bit slot to be filled in later with patch_u32().
+	_FORCE_INLINE_ uint32_t reserve_u32() {
+		uint32_t pos = buffer.size();
+		_grow(4);
+		return pos;
+	}
+	_FORCE_INLINE_ void patch_u32(uint32_t p_pos, uint32_t p_value) { memcpy(buffer.ptr() + p_pos, &p_value, 4); }
+
+	_FORCE_INLINE_ uint32_t size() const { return buffer.size(); }
+	_FORCE_INLINE_ const uint8_t *ptr() const { return buffer.ptr(); }
+	_FORCE_INLINE_ void clear() { buffer.clear(); }
+	// Discards everything written after p_size bytes.
+	_FORCE_INLINE_ void truncate(uint32_t p_size) {
+		if (p_size < buffer.size()) {
+			buffer.resize(p_size);
+		}
+	}
+
+	PackedByteArray to_packed() const {
+		PackedByteArray bytes;
+		bytes.resize(buffer.size());
+		if (buffer.size() > 0) {
+			memcpy(bytes.ptrw(), buffer.ptr(), buffer.size());
+		}
+		return bytes;
+	}
+};
+
+// Reads from a borrowed buffer without copying it. Reading past the end sets the error flag and yields zeros.
+class LimboBinaryReader {
+private:
+	const uint8_t *data = nullptr;
+	uint32_t length = 0;
+	uint32_t pos = 0;
+	bool failed = false;
+
+	_FORCE_INLINE_ const uint8_t *_advance(uint32_t p_size) {
+		if (unlikely(failed || p_size > length - pos)) {
+			failed = true;
+			return nullptr;
+		}
+		const uint8_t *p = data + pos;
+		pos += p_size;
+		return p;
+	}
+
+	template <typename T>
+	_FORCE_INLINE_ T _get() {
+		T value = 0;
+		const uint8_t *p = _advance(sizeof(T));
+		if (p) {
+			memcpy(&value, p, sizeof(T));
+		}
+		return value;
+	}
+
+public:
+	_FORCE_INLINE_ uint8_t get_u8() { return _get<uint8_t>(); }
+	_FORCE_INLINE_ uint32_t get_u32() { return _get<uint32_t>(); }
+	_FORCE_INLINE_ int32_t get_i32() { return _get<int32_t>(); }
+	_FORCE_INLINE_ uint64_t get_u64() { return _get<uint64_t>(); }
+	_FORCE_INLINE_ double get_double() { return _get<double>(); }
+
+	// Returns a pointer into the underlying buffer, or nullptr on failure.
+	_FORCE_INLINE_ const uint8_t *get_bytes(uint32_t p_size) { return _advance(p_size); }
+
+	StringName get_string_name() {
+		uint32_t len = get_u32();
+		const uint8_t *p = _advance(len);
+		if (p == nullptr) {
+			return StringName();
+		}
+		return StringName(String::utf8((const char *)p, len));
+	}
+
+	Variant get_var() {
+		uint32_t len = get_u32();
+		if (len == LIMBO_BINARY_OBJECT_ID) {
+			uint64_t id = get_u64();
+			return id == 0 ? Variant() : Variant(ObjectDB::get_instance(ObjectID(id)));
+		}
+		const uint8_t *p = _advance(len);
+		if (p == nullptr) {
+			return Variant();
+		}
+#ifdef LIMBOAI_MODULE
+		Variant ret;
+		Error err = decode_variant(ret, p, len, nullptr, false);
+		if (err != OK) {
+			failed = true;
+		}
+		return ret;
+#elif LIMBOAI_GDEXTENSION
+		PackedByteArray bytes;
+		bytes.resize(len);
+		memcpy(bytes.ptrw(), p, len);
+		return UtilityFunctions::bytes_to_var(bytes);
+#endif
+	}
+
+	// Returns the encoded bytes of the next value, including its length prefix, without decoding it.
+	const uint8_t *get_var_raw(uint32_t &r_size) {
+		uint32_t start = pos;
+		uint32_t len = get_u32();
+		_advance(len == LIMBO_BINARY_OBJECT_ID ? 8 : len);
+		r_size = pos - start;
+		return failed ? nullptr : data + start;
+	}
+
+	_FORCE_INLINE_ void skip(uint32_t p_size) { _advance(p_size); }
+	_FORCE_INLINE_ void set_error() { failed = true; }
+	_FORCE_INLINE_ bool has_error() const { return failed; }
+	_FORCE_INLINE_ uint32_t get_position() const { return pos; }
+	_FORCE_INLINE_ void seek(uint32_t p_pos) {
+		if (p_pos > length) {
+			failed = true;
+		} else {
+			pos = p_pos;
+		}
+	}
+	_FORCE_INLINE_ bool is_at_end() const { return pos >= length; }
+
+	LimboBinaryReader(const uint8_t *p_data, uint32_t p_length) :
+			data(p_data), length(p_length) {}
+	LimboBinaryReader(const PackedByteArray &p_bytes) :
+			data(p_bytes.ptr()), length(p_bytes.size()) {}
+};
+
+#endif // LIMBO_BINARY_IO_H
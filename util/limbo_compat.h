@@ -40,6 +40,8 @@
 #define BUTTON_SET_ICON(m_btn, m_icon) m_btn->set_icon(m_icon)
 #define RESOURCE_LOAD(m_path, m_hint) ResourceLoader::load(m_path, m_hint)
 #define RESOURCE_LOAD_NO_CACHE(m_path, m_hint) ResourceLoader::load(m_path, m_hint, ResourceFormatLoader::CACHE_MODE_IGNORE)
+#define RESOURCE_LOAD_THREADED_REQUEST(m_path, m_hint) ResourceLoader::load_threaded_request(m_path, m_hint)
+#define RESOURCE_LOAD_THREADED_GET(m_path) ResourceLoader::load_threaded_get(m_path)
 #define RESOURCE_SAVE(m_res, m_path, m_flags) ResourceSaver::save(m_res, m_path, m_flags)
 #define RESOURCE_IS_CACHED(m_path) (ResourceCache::has(m_path))
 #define RESOURCE_EXISTS(m_path, m_type_hint) (ResourceLoader::exists(m_path, m_type_hint))
@@ -51,6 +53,8 @@
 #define FILE_EXISTS(m_path) FileAccess::exists(m_path)
 #define DIR_ACCESS_CREATE() DirAccess::create(DirAccess::ACCESS_RESOURCES)
 #define PERFORMANCE_ADD_CUSTOM_MONITOR(m_id, m_callable) (Performance::get_singleton()->add_custom_monitor(m_id, m_callable, Variant()))
+#define GET_MEM_USAGE() (Memory::get_mem_usage())
+#define HAS_CONNECTIONS(m_obj, m_signal) (m_obj->has_connections(m_signal))
 #define GET_SCRIPT(m_obj) (m_obj->get_script_instance() ? m_obj->get_script_instance()->get_script() : nullptr)
 #define ADD_STYLEBOX_OVERRIDE(m_control, m_name, m_stylebox) (m_control->add_theme_style_override(m_name, m_stylebox))
 #define GET_NODE(m_parent, m_path) m_parent->get_node(m_path)
@@ -125,8 +129,10 @@ using namespace godot;
 #define BUTTON_SET_ICON(m_btn, m_icon) m_btn->set_button_icon(m_icon)
 #define RESOURCE_LOAD(m_path, m_hint) ResourceLoader::get_singleton()->load(m_path, m_hint)
 #define RESOURCE_LOAD_NO_CACHE(m_path, m_hint) ResourceLoader::get_singleton()->load(m_path, m_hint, ResourceLoader::CACHE_MODE_IGNORE)
+#define RESOURCE_LOAD_THREADED_REQUEST(m_path, m_hint) ResourceLoader::get_singleton()->load_threaded_request(m_path, m_hint)
+#define RESOURCE_LOAD_THREADED_GET(m_path) ResourceLoader::get_singleton()->load_threaded_get(m_path)
 #define RESOURCE_SAVE(m_res, m_path, m_flags) ResourceSaver::get_singleton()->save(m_res, m_path, m_flags)
-#define RESOURCE_IS_CACHED(m_path) (ResourceLoader::get_singleton()->has_cached(res_path))
+#define RESOURCE_IS_CACHED(m_path) (ResourceLoader::get_singleton()->has_cached(m_path))
 #define RESOURCE_IS_SCENE_FILE(m_path) (ResourceLoader::get_singleton()->get_recognized_extensions_for_type("PackedScene").has(m_path.get_extension()))
 #define RESOURCE_EXISTS(m_path, m_type_hint) (ResourceLoader::get_singleton()->exists(m_path, m_type_hint))
 #define GET_PROJECT_SETTINGS_DIR() EditorInterface::get_singleton()->get_editor_paths()->get_project_settings_dir()
@@ -136,6 +142,9 @@ using namespace godot;
 #define FILE_EXISTS(m_path) FileAccess::file_exists(m_path)
 #define DIR_ACCESS_CREATE() DirAccess::open("res://")
 #define PERFORMANCE_ADD_CUSTOM_MONITOR(m_id, m_callable) (Performance::get_singleton()->add_custom_monitor(m_id, m_callable))
+#define GET_MEM_USAGE() (OS::get_singleton()->get_static_memory_usage())
+// Querying connections from an extension costs more than emitting a signal without listeners.
+#define HAS_CONNECTIONS(m_obj, m_signal) (true)
 #define GET_SCRIPT(m_obj) (m_obj->get_script())
 #define ADD_STYLEBOX_OVERRIDE(m_control, m_name, m_stylebox) (m_control->add_theme_stylebox_override(m_name, m_stylebox))
 #define GET_NODE(m_parent, m_path) m_parent->get_node_internal(m_path)
@@ -0,0 +1,126 @@
+/**
+ * limbo_property_accessor.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_PROPERTY_ACCESSOR_H
+#define LIMBO_PROPERTY_ACCESSOR_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/object.h"
+#include "core/object/script_language.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/variant.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Accesses a property of an object, resolving the property's getter and setter once instead of on every access.
+// Script properties, indexed properties and properties without plain accessors fall back to Object::get() and Object::set().
+// With GDExtension, method binds are not available, so all properties use the fallback.
+class LimboPropertyAccessor {
+private:
+	StringName property;
+#ifdef LIMBOAI_MODULE
+	MethodBind *getter = nullptr;
+	MethodBind *setter = nullptr;
+#endif
+
+public:
+	_FORCE_INLINE_ const StringName &get_property() const { return property; }
+
+	// Resolves accessors for p_property on p_object. Results are only valid for objects of the same class and script.
+	void setup(Object *p_object, const StringName &p_property) {
+		property = p_property;
+#ifdef LIMBOAI_MODULE
+		getter = nullptr;
+		setter = nullptr;
+		if (p_object == nullptr || p_property == StringName()) {
+			return;
+		}
+
+		// * Script instances are queried before ClassDB, and can shadow native properties.
+		ScriptInstance *si = p_object->get_script_instance();
+		if (si) {
+			bool is_script_property = false;
+			si->get_property_type(p_property, &is_script_property);
+			if (is_script_property) {
+				return;
+			}
+		}
+
+		const StringName cls = p_object->get_class_name();
+		bool is_valid = false;
+		int index = ClassDB::get_property_index(cls, p_property, &is_valid);
+		if (!is_valid || index != -1) {
+			return;
+		}
+
+		StringName getter_name = ClassDB::get_property_getter(cls, p_property);
+		if (getter_name != StringName()) {
+			getter = ClassDB::get_method(cls, getter_name);
+			if (getter && getter->get_argument_count() != 0) {
+				getter = nullptr;
+			}
+		}
+		StringName setter_name = ClassDB::get_property_setter(cls, p_property);
+		if (setter_name != StringName()) {
+			setter = ClassDB::get_method(cls, setter_name);
+			if (setter && setter->get_argument_count() != 1) {
+				setter = nullptr;
+			}
+		}
+#endif
+	}
+
+	_FORCE_INLINE_ Variant get(Object *p_object, bool *r_valid = nullptr) const {
+#ifdef LIMBOAI_MODULE
+		if (getter) {
+			Callable::CallError ce;
+			Variant ret = getter->call(p_object, nullptr, 0, ce);
+			if (r_valid) {
+				*r_valid = ce.error == Callable::CallError::CALL_OK;
+			}
+			return ret;
+		}
+		return p_object->get(property, r_valid);
+#elif LIMBOAI_GDEXTENSION
+		if (r_valid) {
+			*r_valid = true;
+		}
+		return p_object->get(property);
+#endif
+	}
+
+	_FORCE_INLINE_ void set(Object *p_object, const Variant &p_value, bool *r_valid = nullptr) const {
+#ifdef LIMBOAI_MODULE
+		if (setter) {
+			Callable::CallError ce;
+			const Variant *args[1] = { &p_value };
+			setter->call(p_object, args, 1, ce);
+			if (r_valid) {
+				*r_valid = ce.error == Callable::CallError::CALL_OK;
+			}
+			return;
+		}
+		p_object->set(property, p_value, r_valid);
+#elif LIMBOAI_GDEXTENSION
+		if (r_valid) {
+			*r_valid = true;
+		}
+		p_object->set(property, p_value);
+#endif
+	}
+};
+
+#endif // LIMBO_PROPERTY_ACCESSOR_H
@@ -36,7 +36,10 @@ LimboStringNames::LimboStringNames() {
 	_exit = SN("_exit");
 	_generate_name = SN("_generate_name");
 	_get_configuration_warnings = SN("_get_configuration_warnings");
+	_on_awaited_signal = SN("_on_awaited_signal");
 	_replace_task = SN("_replace_task");
+	_resolve_pending_icons = SN("_resolve_pending_icons");
+	_run = SN("_run");
 	_setup = SN("_setup");
 	_tick = SN("_tick");
 	_update = SN("_update");
@@ -99,6 +102,7 @@ LimboStringNames::LimboStringNames() {
 	icon_max_width = SN("icon_max_width");
 	id_pressed = SN("id_pressed");
 	Info = SN("Info");
+	instance_finished = SN("instance_finished");
 	item_collapsed = SN("item_collapsed");
 	item_selected = SN("item_selected");
 	LimboDeselectAll = SN("LimboDeselectAll");
@@ -135,6 +139,7 @@ LimboStringNames::LimboStringNames() {
 	remove_child = SN("remove_child");
 	Rename = SN("Rename");
 	request_open_in_screen = SN("request_open_in_screen");
+	resumed = SN("resumed");
 	rmb_pressed = SN("rmb_pressed");
 	Save = SN("Save");
 	Script = SN("Script");
@@ -145,6 +150,7 @@ LimboStringNames::LimboStringNames() {
 	set_root_task = SN("set_root_task");
 	set_v_scroll = SN("set_v_scroll");
 	setup = SN("setup");
+	state_changed = SN("state_changed");
 	started = SN("started");
 	StatusWarning = SN("StatusWarning");
 	stopped = SN("stopped");
@@ -52,7 +52,10 @@ public:
 	StringName _exit;
 	StringName _generate_name;
 	StringName _get_configuration_warnings;
+	StringName _on_awaited_signal;
 	StringName _replace_task;
+	StringName _resolve_pending_icons;
+	StringName _run;
 	StringName _setup;
 	StringName _tick;
 	StringName _update_banners;
@@ -115,6 +118,7 @@ public:
 	StringName icon_max_width;
 	StringName id_pressed;
 	StringName Info;
+	StringName instance_finished;
 	StringName item_collapsed;
 	StringName item_selected;
 	StringName LimboDeselectAll;
@@ -152,6 +156,7 @@ public:
 	StringName Remove;
 	StringName Rename;
 	StringName request_open_in_screen;
+	StringName resumed;
 	StringName rmb_pressed;
 	StringName Save;
 	StringName Script;
@@ -162,6 +167,7 @@ public:
 	StringName set_root_task;
 	StringName set_v_scroll;
 	StringName setup;
+	StringName state_changed;
 	StringName started;
 	StringName StatusWarning;
 	StringName stopped;
@@ -14,18 +14,62 @@
 #include "limbo_compat.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#ifdef TOOLS_ENABLED
+#include "editor/editor_file_system.h"
+#endif // TOOLS_ENABLED
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
+#ifdef TOOLS_ENABLED
+#include <godot_cpp/classes/editor_file_system.hpp>
+#include <godot_cpp/classes/editor_file_system_directory.hpp>
+#include <godot_cpp/classes/editor_interface.hpp>
+#endif // TOOLS_ENABLED
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 HashMap<String, List<String>> LimboTaskDB::core_tasks;
 HashMap<String, List<String>> LimboTaskDB::tasks_cache;
+PackedStringArray LimboTaskDB::scanned_dirs;
+bool LimboTaskDB::user_tasks_dirty = true;
+uint32_t LimboTaskDB::revision = 0;
+
+#ifdef TOOLS_ENABLED
+// Collects task scripts from the editor's in-memory filesystem tree, avoiding disk access.
+// Returns false if the directory is not known to the editor filesystem (yet).
+static bool _populate_from_editor_fs(const String &p_path, HashMap<String, List<String>> *p_categories) {
+	if (!Engine::get_singleton()->is_editor_hint() || EDITOR_FILE_SYSTEM() == nullptr || EDITOR_FILE_SYSTEM()->is_scanning()) {
+		return false;
+	}
+	EditorFileSystemDirectory *root = EDITOR_FILE_SYSTEM()->get_filesystem_path(p_path);
+	if (root == nullptr) {
+		return false;
+	}
+
+	// Scripts in the root directory and its subdirectories (one level deep), grouped by category.
+	for (int d = -1; d < root->get_subdir_count(); d++) {
+		EditorFileSystemDirectory *efd = d < 0 ? root : root->get_subdir(d);
+		String category = d < 0 ? LimboTaskDB::get_misc_category() : efd->get_name().capitalize();
+		if (!p_categories->has(category)) {
+			p_categories->insert(category, List<String>());
+		}
+		List<String> &tasks = p_categories->get(category);
+		for (int i = 0; i < efd->get_file_count(); i++) {
+			String fn = efd->get_file(i);
+			if (fn.ends_with(".gd") || fn.ends_with(".cs")) {
+				tasks.push_back(efd->get_file_path(i));
+			}
+		}
+	}
+	return true;
+}
+#endif // TOOLS_ENABLED
 
 _FORCE_INLINE_ void _populate_scripted_tasks_from_dir(String p_path, List<String> *p_task_classes) {
 	if (p_path.is_empty()) {
@@ -89,20 +133,63 @@ _FORCE_INLINE_ void _populate_from_user_dir(String p_path, HashMap<String, List<
 }
 
 void LimboTaskDB::scan_user_tasks() {
-	tasks_cache = HashMap<String, List<String>>(core_tasks);
+	PackedStringArray dirs;
+	for (int i = 1; i < 4; i++) {
+		dirs.push_back(ProjectSettings::get_singleton()->get_setting_with_override("limbo_ai/behavior_tree/user_task_dir_" + itos(i)));
+	}
+	if (!user_tasks_dirty && dirs == scanned_dirs) {
+		return;
+	}
 
-	if (!tasks_cache.has(LimboTaskDB::get_misc_category())) {
-		tasks_cache[LimboTaskDB::get_misc_category()] = List<String>();
+	HashMap<String, List<String>> new_cache(core_tasks);
+	if (!new_cache.has(LimboTaskDB::get_misc_category())) {
+		new_cache[LimboTaskDB::get_misc_category()] = List<String>();
 	}
 
-	for (int i = 1; i < 4; i++) {
-		String dir1 = ProjectSettings::get_singleton()->get_setting_with_override("limbo_ai/behavior_tree/user_task_dir_" + itos(i));
-		_populate_from_user_dir(dir1, &tasks_cache);
+	bool complete = true;
+	for (const String &dir : dirs) {
+#ifdef TOOLS_ENABLED
+		if (dir.is_empty()) {
+			continue;
+		}
+		if (_populate_from_editor_fs(dir, &new_cache)) {
+			continue;
+		}
+		// * Editor filesystem is not ready: read from disk and rescan next time.
+		complete = complete && !Engine::get_singleton()->is_editor_hint();
+#endif // TOOLS_ENABLED
+		_populate_from_user_dir(dir, &new_cache);
 	}
 
-	for (KeyValue<String, List<String>> &E : tasks_cache) {
+	for (KeyValue<String, List<String>> &E : new_cache) {
 		E.value.sort_custom<ComparatorByTaskName>();
 	}
+
+	bool changed = new_cache.size() != tasks_cache.size();
+	for (const KeyValue<String, List<String>> &E : new_cache) {
+		if (changed) {
+			break;
+		}
+		const List<String> *old_tasks = tasks_cache.getptr(E.key);
+		if (old_tasks == nullptr || old_tasks->size() != E.value.size()) {
+			changed = true;
+			break;
+		}
+		const List<String>::Element *O = old_tasks->front();
+		for (const List<String>::Element *N = E.value.front(); N; N = N->next(), O = O->next()) {
+			if (N->get() != O->get()) {
+				changed = true;
+				break;
+			}
+		}
+	}
+
+	if (changed) {
+		tasks_cache = new_cache;
+		revision += 1;
+	}
+	scanned_dirs = dirs;
+	user_tasks_dirty = !complete;
 }
 
 List<String> LimboTaskDB::get_categories() {
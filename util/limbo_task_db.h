@@ -31,6 +31,11 @@ private:
 	static HashMap<String, List<String>> core_tasks;
 	static HashMap<String, List<String>> tasks_cache;
 
+	// User task directories are rescanned only when marked dirty or when their settings change.
+	static PackedStringArray scanned_dirs;
+	static bool user_tasks_dirty;
+	static uint32_t revision;
+
 	struct ComparatorByTaskName {
 		bool operator()(const String &p_left, const String &p_right) const {
 			return get_task_name(p_left) < get_task_name(p_right);
@@ -52,6 +57,9 @@ public:
 	}
 
 	static void scan_user_tasks();
+	static void mark_user_tasks_dirty() { user_tasks_dirty = true; }
+	// Incremented whenever a scan changes the list of available tasks.
+	static uint32_t get_revision() { return revision; }
 	static _FORCE_INLINE_ String get_misc_category() { return "Misc"; }
 	static List<String> get_categories();
 	static List<String> get_tasks_in_category(const String &p_category);
@@ -79,6 +79,19 @@ String LimboUtility::get_status_name(int p_status) const {
 Ref<Texture2D> LimboUtility::get_task_icon(String p_class_or_script_path) const {
 	ERR_FAIL_COND_V_MSG(p_class_or_script_path.is_empty(), Variant(), "BTTask: script path or class cannot be empty.");
 
+	HashMap<String, Ref<Texture2D>>::ConstIterator E = task_icon_cache.find(p_class_or_script_path);
+	if (E) {
+		return E->value;
+	}
+	Ref<Texture2D> icon = _resolve_task_icon(p_class_or_script_path);
+	if (icon.is_valid()) {
+		// * Misses are not cached: the editor theme may not be ready yet.
+		task_icon_cache.insert(p_class_or_script_path, icon);
+	}
+	return icon;
+}
+
+Ref<Texture2D> LimboUtility::_resolve_task_icon(const String &p_class_or_script_path) const {
 #if defined(TOOLS_ENABLED) && defined(LIMBOAI_MODULE)
 	// * Using editor theme
 	if (Engine::get_singleton()->is_editor_hint()) {
@@ -525,6 +538,26 @@ PackedInt32Array LimboUtility::get_property_hints_allowed_for_type(Variant::Type
 
 #ifdef TOOLS_ENABLED
 
+String LimboUtility::get_task_name_cached(const Ref<BTTask> &p_task) {
+	ERR_FAIL_COND_V(p_task.is_null(), String());
+	if (!p_task->get_custom_name().is_empty()) {
+		return p_task->get_custom_name();
+	}
+	uint64_t id = uint64_t(p_task->get_instance_id());
+	HashMap<uint64_t, String>::ConstIterator E = task_name_cache.find(id);
+	if (E) {
+		return E->value;
+	}
+	String name = p_task->get_task_name();
+	task_name_cache.insert(id, name);
+	return name;
+}
+
+void LimboUtility::invalidate_task_name(const Ref<BTTask> &p_task) {
+	ERR_FAIL_COND(p_task.is_null());
+	task_name_cache.erase(uint64_t(p_task->get_instance_id()));
+}
+
 Ref<Shortcut> LimboUtility::add_shortcut(const String &p_path, const String &p_name, Key p_keycode) {
 	Ref<Shortcut> sc = memnew(Shortcut);
 	sc->set_name(p_name);
@@ -36,14 +36,23 @@ using namespace godot;
 
 #define LOGICAL_XOR(a, b) (a) ? !(b) : (b)
 
+class BTTask;
+
 class LimboUtility : public Object {
 	GDCLASS(LimboUtility, Object);
 
 private:
+	// Task icons by class name or script path. Cleared when scripts are reloaded or the editor theme changes.
+	mutable HashMap<String, Ref<Texture2D>> task_icon_cache;
+
 #ifdef TOOLS_ENABLED
 	HashMap<String, Ref<Shortcut>> shortcuts;
+	// Generated task names by task instance ID. Entries are dropped by TaskTree when their items are freed.
+	HashMap<uint64_t, String> task_name_cache;
 #endif // TOOLS_ENABLED
 
+	Ref<Texture2D> _resolve_task_icon(const String &p_class_or_script_path) const;
+
 public:
 	enum CheckType : unsigned int {
 		CHECK_EQUAL,
@@ -80,6 +89,7 @@ public:
 	String decorate_output_var(String p_variable) const;
 	String get_status_name(int p_status) const;
 	Ref<Texture2D> get_task_icon(String p_class_or_script_path) const;
+	void clear_task_icon_cache() { task_icon_cache.clear(); }
 
 	String get_check_operator_string(CheckType p_check_type) const;
 	bool perform_check(CheckType p_check_type, const Variant &left_value, const Variant &right_value);
@@ -91,6 +101,11 @@ public:
 	PackedInt32Array get_property_hints_allowed_for_type(Variant::Type p_type) const;
 
 #ifdef TOOLS_ENABLED
+	// Same as BTTask::get_task_name(), but avoids calling _generate_name() again until the task is invalidated.
+	String get_task_name_cached(const Ref<BTTask> &p_task);
+	void invalidate_task_name(const Ref<BTTask> &p_task);
+	void clear_task_name_cache() { task_name_cache.clear(); }
+
 	Ref<Shortcut> add_shortcut(const String &p_path, const String &p_name, Key p_keycode = LW_KEY(NONE));
 	bool is_shortcut(const String &p_path, const Ref<InputEvent> &p_event) const;
 	Ref<Shortcut> get_shortcut(const String &p_path) const;